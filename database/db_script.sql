@@ -30,6 +30,7 @@ CREATE TABLE TEAMS (
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX team_unique_name_idx ON teams ((document->>'name'));
+CREATE INDEX team_created_at_id_idx ON TEAMS (created_at, id);
 
 CREATE TABLE TOURNAMENTS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
@@ -38,6 +39,31 @@ CREATE TABLE TOURNAMENTS (
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX tournament_unique_name_idx ON TOURNAMENTS ((document->>'name'));
+CREATE INDEX tournament_created_at_id_idx ON TOURNAMENTS (created_at, id);
+
+-- when a collection last changed and how many writing statements it has seen, kept by the triggers below so
+-- the collection version of GET /tournaments is a single row instead of an aggregate over the whole table
+CREATE TABLE COLLECTION_VERSIONS (
+    name TEXT PRIMARY KEY,
+    last_update_date TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    revision BIGINT NOT NULL DEFAULT 0
+);
+INSERT INTO COLLECTION_VERSIONS (name) VALUES ('teams'), ('tournaments');
+
+-- once per statement, a statement that changes no row still bumps it and only costs clients a full response
+CREATE FUNCTION bump_collection_version() RETURNS trigger AS $$
+BEGIN
+    UPDATE COLLECTION_VERSIONS
+    SET last_update_date = greatest(last_update_date, localtimestamp), revision = revision + 1
+    WHERE name = TG_ARGV[0];
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER teams_collection_version AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON TEAMS
+    FOR EACH STATEMENT EXECUTE FUNCTION bump_collection_version('teams');
+CREATE TRIGGER tournaments_collection_version AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON TOURNAMENTS
+    FOR EACH STATEMENT EXECUTE FUNCTION bump_collection_version('tournaments');
 
 CREATE TABLE GROUPS (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
@@ -47,13 +73,40 @@ CREATE TABLE GROUPS (
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
 CREATE UNIQUE INDEX tournament_group_unique_name_idx ON GROUPS (tournament_id,(document->>'name'));
+-- keyset order of the NDJSON group export
+CREATE INDEX group_created_at_id_idx ON GROUPS (created_at, id);
+
+-- group membership mirrored out of GROUPS.document->'teams', a team belongs to at most one group per tournament
+CREATE TABLE GROUP_TEAMS (
+    tournament_id UUID not null references TOURNAMENTS(ID),
+    group_id UUID not null references GROUPS(ID) on delete cascade,
+    team_id UUID not null references TEAMS(ID),
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    PRIMARY KEY (tournament_id, team_id)
+);
+CREATE INDEX group_teams_group_idx ON GROUP_TEAMS (group_id);
 
 CREATE TABLE MATCHES (
     id UUID DEFAULT uuid_generate_v4() PRIMARY KEY,
+    TOURNAMENT_ID UUID not null references TOURNAMENTS(ID),
+    round INT not null,
     document JSONB NOT NULL,
     last_update_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
+CREATE INDEX match_tournament_round_idx ON MATCHES (tournament_id, round, id);
+CREATE INDEX match_created_at_id_idx ON MATCHES (created_at, id);
+-- matches still waiting for their visitor team, the predicate must match FindLastOpenMatch verbatim
+CREATE INDEX match_open_idx ON MATCHES (tournament_id, round DESC, created_at DESC, id DESC)
+    WHERE coalesce(document->>'visitorTeamId', '') = '';
+
+-- events written in the same transaction as the change they announce, relayed to the broker and deleted
+CREATE TABLE OUTBOX (
+    id BIGINT GENERATED ALWAYS AS IDENTITY PRIMARY KEY,
+    queue TEXT NOT NULL,
+    payload TEXT NOT NULL,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+);
 
 GRANT SELECT ON ALL TABLES IN SCHEMA public TO tournament_svc;
 GRANT DELETE ON ALL TABLES IN SCHEMA public TO tournament_svc;
@@ -0,0 +1,26 @@
+-- Brings a database created before GROUP_TEAMS existed up to date, db_script.sql already creates it on new ones.
+-- podman exec -i tournament_db psql -v ON_ERROR_STOP=1 -U tournament_admin -d tournament_db < 001_group_teams.sql
+-- Safe to run again: the table and index are only created when missing and the backfill skips rows already there.
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS GROUP_TEAMS (
+    tournament_id UUID not null references TOURNAMENTS(ID),
+    group_id UUID not null references GROUPS(ID) on delete cascade,
+    team_id UUID not null references TEAMS(ID),
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    PRIMARY KEY (tournament_id, team_id)
+);
+CREATE INDEX IF NOT EXISTS group_teams_group_idx ON GROUP_TEAMS (group_id);
+
+-- membership of the groups written so far, taken from their documents. Teams that no longer exist are left out,
+-- and a team listed in two groups of one tournament keeps the first one found
+INSERT INTO GROUP_TEAMS (tournament_id, group_id, team_id)
+SELECT g.tournament_id, g.id, t.id
+FROM GROUPS g, jsonb_array_elements(coalesce(g.document -> 'teams', '[]'::jsonb)) team
+JOIN TEAMS t ON t.id::text = team ->> 'id'
+ON CONFLICT DO NOTHING;
+
+GRANT SELECT, INSERT, UPDATE, DELETE ON GROUP_TEAMS TO tournament_svc;
+
+COMMIT;
@@ -0,0 +1,27 @@
+-- Adds the tournament and round columns MatchRepository queries, plus their indexes, to a MATCHES table created
+-- before they existed. db_script.sql already creates them on new databases.
+-- podman exec -i tournament_db psql -v ON_ERROR_STOP=1 -U tournament_admin -d tournament_db < 002_match_schedule.sql
+-- Safe to run again: columns and indexes are only added when missing and the backfill only touches unset rows.
+
+BEGIN;
+
+ALTER TABLE MATCHES ADD COLUMN IF NOT EXISTS tournament_id UUID references TOURNAMENTS(ID);
+ALTER TABLE MATCHES ADD COLUMN IF NOT EXISTS round INT;
+
+-- older rows only carry them in the document, a match without a round is the first one
+UPDATE MATCHES
+SET tournament_id = coalesce(tournament_id, nullif(document ->> 'tournamentId', '')::uuid),
+    round = coalesce(round, (document ->> 'round')::int, 1)
+WHERE tournament_id IS NULL OR round IS NULL;
+
+-- a match that names no tournament fails here and rolls the whole migration back instead of being dropped
+ALTER TABLE MATCHES ALTER COLUMN tournament_id SET NOT NULL;
+ALTER TABLE MATCHES ALTER COLUMN round SET NOT NULL;
+
+CREATE INDEX IF NOT EXISTS match_tournament_round_idx ON MATCHES (tournament_id, round, id);
+CREATE INDEX IF NOT EXISTS match_created_at_id_idx ON MATCHES (created_at, id);
+-- matches still waiting for their visitor team, the predicate must match FindLastOpenMatch verbatim
+CREATE INDEX IF NOT EXISTS match_open_idx ON MATCHES (tournament_id, round DESC, created_at DESC, id DESC)
+    WHERE coalesce(document->>'visitorTeamId', '') = '';
+
+COMMIT;
@@ -0,0 +1,5 @@
+-- Index behind the keyset batches of /export/groups, db_script.sql already creates it on new databases.
+-- podman exec -i tournament_db psql -v ON_ERROR_STOP=1 -U tournament_admin -d tournament_db < 003_group_created_at_index.sql
+-- Safe to run again. Built concurrently so group writes are not blocked meanwhile, which is why there is no transaction.
+
+CREATE INDEX CONCURRENTLY IF NOT EXISTS group_created_at_id_idx ON GROUPS (created_at, id);
@@ -0,0 +1,38 @@
+-- Moves the collection versions of TEAMS and TOURNAMENTS to a counter table kept by triggers, db_script.sql already creates it on new databases.
+-- podman exec -i tournament_db psql -v ON_ERROR_STOP=1 -U tournament_admin -d tournament_db < 004_collection_versions.sql
+-- Safe to run again: the table, rows and triggers are only created when missing and the function is replaced.
+
+BEGIN;
+
+CREATE TABLE IF NOT EXISTS COLLECTION_VERSIONS (
+    name TEXT PRIMARY KEY,
+    last_update_date TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    revision BIGINT NOT NULL DEFAULT 0
+);
+-- starts from the newest row, so If-Modified-Since sent before the migration is still answered with 304
+INSERT INTO COLLECTION_VERSIONS (name, last_update_date)
+SELECT 'teams', coalesce(max(last_update_date), localtimestamp) FROM TEAMS
+UNION ALL
+SELECT 'tournaments', coalesce(max(last_update_date), localtimestamp) FROM TOURNAMENTS
+ON CONFLICT DO NOTHING;
+
+CREATE OR REPLACE FUNCTION bump_collection_version() RETURNS trigger AS $$
+BEGIN
+    UPDATE COLLECTION_VERSIONS
+    SET last_update_date = greatest(last_update_date, localtimestamp), revision = revision + 1
+    WHERE name = TG_ARGV[0];
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE OR REPLACE TRIGGER teams_collection_version AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON TEAMS
+    FOR EACH STATEMENT EXECUTE FUNCTION bump_collection_version('teams');
+CREATE OR REPLACE TRIGGER tournaments_collection_version AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON TOURNAMENTS
+    FOR EACH STATEMENT EXECUTE FUNCTION bump_collection_version('tournaments');
+
+-- only the aggregate over TOURNAMENTS used it
+DROP INDEX IF EXISTS tournament_last_update_idx;
+
+GRANT SELECT, UPDATE ON COLLECTION_VERSIONS TO tournament_svc;
+
+COMMIT;
@@ -0,0 +1,118 @@
+#ifndef COMMON_ENTITY_CACHE_HPP
+#define COMMON_ENTITY_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "domain/Id.hpp"
+
+struct CacheStats {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+};
+
+/**
+ * Bounded, TTL based entity cache. Keys are spread over shards guarded by a shared_mutex so lookups
+ * only take a shared lock; eviction is second chance (CLOCK) so a hit never needs the exclusive lock.
+ * Keyed by the 16 byte id itself, a lookup neither formats nor hashes its text.
+ */
+template<typename Type, typename Key = domain::Id>
+class EntityCache {
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Entry {
+        std::shared_ptr<const Type> value;
+        std::chrono::steady_clock::time_point expiresAt;
+        typename std::list<Key>::iterator position;
+        std::atomic<bool> referenced{false};
+    };
+
+    struct Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<Key, Entry> entries;
+        std::list<Key> clock;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+    size_t shardCapacity;
+    std::chrono::milliseconds ttl;
+    CacheStats stats;
+
+    Shard& ShardFor(const Key& key) {
+        return shards[std::hash<Key>{}(key) % SHARD_COUNT];
+    }
+
+    void Evict(Shard& shard) {
+        while (shard.entries.size() > shardCapacity) {
+            auto entry = shard.entries.find(shard.clock.front());
+            if (entry->second.referenced.exchange(false, std::memory_order_relaxed)) {
+                shard.clock.splice(shard.clock.end(), shard.clock, shard.clock.begin());
+                continue;
+            }
+            shard.clock.pop_front();
+            shard.entries.erase(entry);
+            stats.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    EntityCache(const size_t capacity, const std::chrono::milliseconds ttl)
+        : shardCapacity(std::max<size_t>(1, capacity / SHARD_COUNT)), ttl(ttl) {}
+
+    std::shared_ptr<const Type> Find(const Key& key) {
+        auto& shard = ShardFor(key);
+        std::shared_lock lock(shard.mutex);
+        const auto entry = shard.entries.find(key);
+        if (entry == shard.entries.end() || entry->second.expiresAt < std::chrono::steady_clock::now()) {
+            stats.misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        entry->second.referenced.store(true, std::memory_order_relaxed);
+        stats.hits.fetch_add(1, std::memory_order_relaxed);
+        return entry->second.value;
+    }
+
+    void Put(const Key& key, std::shared_ptr<const Type> value) {
+        auto& shard = ShardFor(key);
+        std::unique_lock lock(shard.mutex);
+        auto [entry, inserted] = shard.entries.try_emplace(key);
+        entry->second.value = std::move(value);
+        entry->second.expiresAt = std::chrono::steady_clock::now() + ttl;
+        if (inserted) {
+            entry->second.position = shard.clock.insert(shard.clock.end(), key);
+            Evict(shard);
+        }
+    }
+
+    void Invalidate(const Key& key) {
+        auto& shard = ShardFor(key);
+        std::unique_lock lock(shard.mutex);
+        if (const auto entry = shard.entries.find(key); entry != shard.entries.end()) {
+            shard.clock.erase(entry->second.position);
+            shard.entries.erase(entry);
+        }
+    }
+
+    [[nodiscard]] size_t Size() {
+        size_t size = 0;
+        for (auto& shard : shards) {
+            std::shared_lock lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+    [[nodiscard]] const CacheStats& Stats() const {
+        return stats;
+    }
+};
+
+#endif //COMMON_ENTITY_CACHE_HPP
@@ -0,0 +1,124 @@
+#ifndef COMMON_CACHE_INVALIDATION_BUS_HPP
+#define COMMON_CACHE_INVALIDATION_BUS_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <print>
+#include <cms/MessageListener.h>
+#include <cms/MessageConsumer.h>
+#include <cms/MessageProducer.h>
+#include <cms/TextMessage.h>
+#include <cms/Topic.h>
+
+#include "cms/ConnectionManager.hpp"
+
+/**
+ * Broadcasts cache invalidations to every service instance over a broker topic. Each instance
+ * subscribes with its own consumer, so a write on one instance evicts the entry everywhere.
+ * Sessions are opened once the broker connection is up, invalidations published before that
+ * are dropped and left to the TTL.
+ */
+class CacheInvalidationBus : public cms::MessageListener {
+    static constexpr std::string_view TOPIC = "cache.invalidate";
+    static constexpr std::string_view CACHE_PROPERTY = "cache";
+
+    std::shared_ptr<ConnectionManager> connectionManager;
+
+    std::mutex publishMutex;
+    std::shared_ptr<cms::Session> publishSession;
+    std::unique_ptr<cms::Topic> publishTopic;
+    std::unique_ptr<cms::MessageProducer> producer;
+
+    std::shared_ptr<cms::Session> subscribeSession;
+    std::unique_ptr<cms::Topic> subscribeTopic;
+    std::unique_ptr<cms::MessageConsumer> consumer;
+
+    std::mutex handlersMutex;
+    std::unordered_map<std::string, std::vector<std::function<void(const std::string&)>>> handlers;
+
+public:
+    explicit CacheInvalidationBus(const std::shared_ptr<ConnectionManager>& connectionManager);
+    ~CacheInvalidationBus() override;
+
+    void Connect();
+    void Subscribe(const std::string_view& cacheName, std::function<void(const std::string&)> handler);
+    void Publish(const std::string_view& cacheName, const std::string_view& key);
+    void onMessage(const cms::Message* message) override;
+};
+
+inline CacheInvalidationBus::CacheInvalidationBus(const std::shared_ptr<ConnectionManager>& connectionManager) : connectionManager(connectionManager) {
+    // single instance living as long as the container, the callback never outlives it
+    connectionManager->OnConnected([this] { Connect(); });
+}
+
+inline void CacheInvalidationBus::Connect() {
+    std::lock_guard lock(publishMutex);
+    publishSession = connectionManager->CreateSession();
+    publishTopic = std::unique_ptr<cms::Topic>(publishSession->createTopic(TOPIC.data()));
+    producer = std::unique_ptr<cms::MessageProducer>(publishSession->createProducer(publishTopic.get()));
+    producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+
+    subscribeSession = connectionManager->CreateSession();
+    subscribeTopic = std::unique_ptr<cms::Topic>(subscribeSession->createTopic(TOPIC.data()));
+    consumer = std::unique_ptr<cms::MessageConsumer>(subscribeSession->createConsumer(subscribeTopic.get()));
+    consumer->setMessageListener(this);
+}
+
+inline CacheInvalidationBus::~CacheInvalidationBus() {
+    std::lock_guard lock(publishMutex);
+    try {
+        if (consumer != nullptr) {
+            consumer->close();
+            subscribeSession->close();
+        }
+        if (producer != nullptr) {
+            producer->close();
+            publishSession->close();
+        }
+    } catch (const cms::CMSException&) {
+    }
+}
+
+inline void CacheInvalidationBus::Subscribe(const std::string_view& cacheName, std::function<void(const std::string&)> handler) {
+    std::lock_guard lock(handlersMutex);
+    handlers[std::string(cacheName)].push_back(std::move(handler));
+}
+
+inline void CacheInvalidationBus::Publish(const std::string_view& cacheName, const std::string_view& key) {
+    // the local entry is already gone and the TTL bounds staleness elsewhere, so a broker hiccup must not fail the write
+    try {
+        std::lock_guard lock(publishMutex);
+        if (producer == nullptr) {
+            std::println("cache invalidation for {} {} not published: broker not connected yet", cacheName, key);
+            return;
+        }
+        const auto message = std::unique_ptr<cms::TextMessage>(publishSession->createTextMessage(std::string(key)));
+        message->setStringProperty(CACHE_PROPERTY.data(), std::string(cacheName));
+        producer->send(message.get());
+    } catch (const cms::CMSException& e) {
+        std::println("cache invalidation for {} {} not published: {}", cacheName, key, e.getMessage());
+    }
+}
+
+inline void CacheInvalidationBus::onMessage(const cms::Message* message) {
+    const auto text = dynamic_cast<const cms::TextMessage*>(message);
+    if (text == nullptr || !text->propertyExists(CACHE_PROPERTY.data())) {
+        return;
+    }
+    const std::string cacheName = text->getStringProperty(CACHE_PROPERTY.data());
+    const std::string key = text->getText();
+
+    std::lock_guard lock(handlersMutex);
+    if (const auto cacheHandlers = handlers.find(cacheName); cacheHandlers != handlers.end()) {
+        for (const auto& handler : cacheHandlers->second) {
+            handler(key);
+        }
+    }
+}
+
+#endif //COMMON_CACHE_INVALIDATION_BUS_HPP
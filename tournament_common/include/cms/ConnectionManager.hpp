@@ -8,26 +8,96 @@
 #include <cms/Connection.h>
 #include <cms/Session.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <print>
+#include <thread>
+#include <vector>
+
+#include "configuration/StartupReport.hpp"
 
 class ConnectionManager {
 public:
+    ~ConnectionManager() {
+        if (connector.joinable()) {
+            connector.join();
+        }
+    }
+
+    // connects in the background, a failover URI keeps retrying until the broker answers
     void initialize(const std::string_view& brokerURI) {
         factory = std::make_unique<activemq::core::ActiveMQConnectionFactory>(brokerURI.data());
-        connection = std::shared_ptr<cms::Connection>(factory->createConnection());
+        connector = std::thread([this] {
+            std::vector<std::function<void()>> callbacks;
+            try {
+                auto opened = std::shared_ptr<cms::Connection>(factory->createConnection());
+                opened->start();
+                std::lock_guard lock(mutex);
+                connection = opened;
+                callbacks.swap(onConnected);
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                failure = std::current_exception();
+            }
+            connected.notify_all();
+            if (failure) {
+                return;
+            }
+            config::StartupReport::Instance().Mark("broker connected");
+            for (const auto& callback : callbacks) {
+                try {
+                    callback();
+                } catch (const std::exception& e) {
+                    std::println("broker connected callback failed: {}", e.what());
+                }
+            }
+        });
+    }
 
-        connection->start();
+    // runs callback on the connecting thread once connected, or right away when already connected
+    void OnConnected(std::function<void()> callback) {
+        {
+            std::lock_guard lock(mutex);
+            if (connection == nullptr) {
+                onConnected.push_back(std::move(callback));
+                return;
+            }
+        }
+        callback();
     }
 
-    [[nodiscard]] std::shared_ptr<cms::Connection> Connection() const { return connection; }
+    [[nodiscard]] bool IsConnected() const {
+        std::lock_guard lock(mutex);
+        return connection != nullptr;
+    }
+
+    // both wait for the background connect
+    [[nodiscard]] std::shared_ptr<cms::Connection> Connection() const { return AwaitConnection(); }
 
     [[nodiscard]] std::shared_ptr<cms::Session> CreateSession() const {
-        return std::shared_ptr<cms::Session>(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+        return std::shared_ptr<cms::Session>(AwaitConnection()->createSession(cms::Session::AUTO_ACKNOWLEDGE));
     }
 
 private:
     std::unique_ptr<activemq::core::ActiveMQConnectionFactory> factory;
+    mutable std::mutex mutex;
+    mutable std::condition_variable connected;
     std::shared_ptr<cms::Connection> connection;
+    std::exception_ptr failure;
+    std::vector<std::function<void()>> onConnected;
+    std::thread connector;
+
+    [[nodiscard]] std::shared_ptr<cms::Connection> AwaitConnection() const {
+        std::unique_lock lock(mutex);
+        connected.wait(lock, [this] { return connection != nullptr || failure != nullptr; });
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        return connection;
+    }
 };
 
-#endif //SERVICES_CONNECTION_MANAGER_HPP
\ No newline at end of file
+#endif //SERVICES_CONNECTION_MANAGER_HPP
@@ -0,0 +1,183 @@
+#ifndef COMMON_OUTBOX_RELAY_HPP
+#define COMMON_OUTBOX_RELAY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cms/CMSException.h>
+#include <cms/MessageProducer.h>
+#include <cms/Queue.h>
+#include <cms/TextMessage.h>
+
+#include "cms/ConnectionManager.hpp"
+#include "configuration/OutboxConfiguration.hpp"
+#include "metrics/Metrics.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+
+struct OutboxRelayStats {
+    std::atomic<uint64_t> published{0};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> failures{0};
+    // age of the oldest message in the last batch, 0 once the outbox is drained
+    std::atomic<int64_t> lagMillis{0};
+};
+
+/**
+ * Drains the OUTBOX table to the broker on a background thread. Each batch is claimed with
+ * FOR UPDATE SKIP LOCKED, so several service instances relay side by side without sending the
+ * same row twice, and the rows are deleted in the transaction that published them. A broker
+ * failure rolls the batch back and it is sent again, delivery is at least once.
+ */
+class OutboxRelay {
+    static inline PreparedStatement& SELECT_OUTBOX_BATCH = StatementRegistry::Instance().Declare("select_outbox_batch", R"(
+        select id, queue, payload, (extract(epoch from CURRENT_TIMESTAMP - created_at) * 1000)::bigint as age_ms
+        from OUTBOX
+        order by id
+        limit $1
+        for update skip locked
+    )");
+    static inline PreparedStatement& DELETE_OUTBOX = StatementRegistry::Instance().Declare(
+        "delete_outbox", "delete from OUTBOX where id = ANY($1::bigint[])");
+
+    std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    std::shared_ptr<ConnectionManager> connectionManager;
+    config::OutboxConfiguration configuration;
+    OutboxRelayStats stats;
+    metrics::Histogram& sendLatency = metrics::Registry::Instance().GetHistogram(
+        "broker_send_seconds", "Time the broker took to accept a persistent message", {{"sender", "outbox"}});
+    std::vector<metrics::Sampler> samplers;
+
+    // only touched by the relay thread, reused across batches
+    std::shared_ptr<cms::Session> session;
+    std::unordered_map<std::string, std::pair<std::unique_ptr<cms::Queue>, std::unique_ptr<cms::MessageProducer>>> producers;
+
+    std::mutex waitMutex;
+    std::condition_variable_any wake;
+    // declared last so the thread is stopped before the members it uses go away
+    std::jthread worker;
+
+    cms::MessageProducer& Producer(const std::string& queue);
+    void ResetSession();
+    size_t RelayBatch();
+    void Run(const std::stop_token& stop);
+
+public:
+    OutboxRelay(const std::shared_ptr<IDbConnectionProvider>& connectionProvider, const std::shared_ptr<ConnectionManager>& connectionManager, const config::OutboxConfiguration& configuration);
+    ~OutboxRelay();
+
+    [[nodiscard]] const OutboxRelayStats& Stats() const { return stats; }
+};
+
+inline OutboxRelay::OutboxRelay(const std::shared_ptr<IDbConnectionProvider>& connectionProvider, const std::shared_ptr<ConnectionManager>& connectionManager, const config::OutboxConfiguration& configuration)
+    : connectionProvider(connectionProvider), connectionManager(connectionManager), configuration(configuration),
+      worker([this](const std::stop_token& stop) { Run(stop); }) {
+    auto& registry = metrics::Registry::Instance();
+    samplers.push_back(registry.Sample("outbox_published_total", "Outbox messages published to the broker", metrics::Type::COUNTER, {},
+        [this] { return static_cast<double>(stats.published.load(std::memory_order_relaxed)); }));
+    samplers.push_back(registry.Sample("outbox_relay_failures_total", "Outbox batches rolled back after a failure", metrics::Type::COUNTER, {},
+        [this] { return static_cast<double>(stats.failures.load(std::memory_order_relaxed)); }));
+    samplers.push_back(registry.Sample("outbox_lag_seconds", "Age of the oldest message in the last outbox batch", metrics::Type::GAUGE, {},
+        [this] { return static_cast<double>(stats.lagMillis.load(std::memory_order_relaxed)) / 1000; }));
+}
+
+inline OutboxRelay::~OutboxRelay() {
+    worker.request_stop();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    ResetSession();
+}
+
+inline cms::MessageProducer& OutboxRelay::Producer(const std::string& queue) {
+    auto& [destination, producer] = producers[queue];
+    if (producer == nullptr) {
+        destination = std::unique_ptr<cms::Queue>(session->createQueue(queue));
+        producer = std::unique_ptr<cms::MessageProducer>(session->createProducer(destination.get()));
+        producer->setDeliveryMode(cms::DeliveryMode::PERSISTENT);
+    }
+    return *producer;
+}
+
+inline void OutboxRelay::ResetSession() {
+    try {
+        for (auto& [queue, producer] : producers) {
+            if (producer.second != nullptr) {
+                producer.second->close();
+            }
+        }
+        if (session != nullptr) {
+            session->close();
+        }
+    } catch (const cms::CMSException&) {
+    }
+    producers.clear();
+    session.reset();
+}
+
+inline size_t OutboxRelay::RelayBatch() {
+    if (session == nullptr) {
+        // CreateSession waits for the broker, so a batch is never claimed before it is reachable; holding a
+        // pooled connection and the row locks through an outage would also keep the destructor from joining
+        if (!connectionManager->IsConnected()) {
+            return 0;
+        }
+        session = connectionManager->CreateSession();
+    }
+
+    auto pooled = connectionProvider->Connection();
+    pqxx::work tx(*pooled);
+    const pqxx::result rows = Execute(pooled, tx, SELECT_OUTBOX_BATCH, pqxx::params{configuration.batchSize});
+    if (rows.empty()) {
+        tx.commit();
+        stats.lagMillis.store(0, std::memory_order_relaxed);
+        return 0;
+    }
+    stats.lagMillis.store(rows[0]["age_ms"].as<int64_t>(), std::memory_order_relaxed);
+
+    std::vector<int64_t> ids;
+    ids.reserve(rows.size());
+    for (const auto& row : rows) {
+        auto& producer = Producer(row["queue"].c_str());
+        const auto message = std::unique_ptr<cms::TextMessage>(session->createTextMessage(row["payload"].c_str()));
+        const auto started = std::chrono::steady_clock::now();
+        producer.send(message.get());
+        sendLatency.Observe(metrics::Since(started));
+        ids.push_back(row["id"].as<int64_t>());
+    }
+    Execute(pooled, tx, DELETE_OUTBOX, pqxx::params{ids});
+    tx.commit();
+
+    stats.published.fetch_add(ids.size(), std::memory_order_relaxed);
+    stats.batches.fetch_add(1, std::memory_order_relaxed);
+    return ids.size();
+}
+
+inline void OutboxRelay::Run(const std::stop_token& stop) {
+    while (!stop.stop_requested()) {
+        size_t relayed = 0;
+        try {
+            relayed = RelayBatch();
+        } catch (const cms::CMSException& e) {
+            std::println("Outbox relay could not publish: {}", e.getMessage());
+            stats.failures.fetch_add(1, std::memory_order_relaxed);
+            ResetSession();
+        } catch (const std::exception& e) {
+            std::println("Outbox relay failed: {}", e.what());
+            stats.failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (relayed < configuration.batchSize) {
+            std::unique_lock lock(waitMutex);
+            wake.wait_for(lock, stop, configuration.pollInterval, [] { return false; });
+        }
+    }
+}
+
+#endif //COMMON_OUTBOX_RELAY_HPP
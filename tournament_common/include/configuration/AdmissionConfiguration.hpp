@@ -0,0 +1,62 @@
+#ifndef ADMISSION_CONFIGURATION_HPP
+#define ADMISSION_CONFIGURATION_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    struct AdmissionConfiguration {
+        // deadline of every request, a client can ask for less through deadlineHeader but never for more
+        std::chrono::milliseconds requestTimeout{5000};
+        // shortest deadline a client may ask for
+        std::chrono::milliseconds minRequestTimeout{50};
+        // milliseconds the client is willing to wait
+        std::string deadlineHeader = "X-Request-Timeout-Ms";
+        // concurrency limit before the limiter has measured anything, and its bounds
+        size_t initialLimit = 32;
+        size_t minLimit = 4;
+        size_t maxLimit = 512;
+        // latency samples averaged for each limit update
+        size_t sampleWindow = 100;
+        // recent latency may exceed the long-term one by this factor before the limit goes down
+        double latencyTolerance = 1.5;
+        // weight of a new limit estimate against the current limit
+        double smoothing = 0.2;
+        std::chrono::seconds retryAfter{1};
+        // path prefixes never shed, so load balancer health checks and scrapes keep working under load
+        std::vector<std::string> exemptPaths{"/health", "/metrics"};
+    };
+
+    inline void from_json(const nlohmann::json& json, AdmissionConfiguration& admissionConfiguration) {
+        if (json.contains("requestTimeoutMs"))
+            admissionConfiguration.requestTimeout = std::chrono::milliseconds(json.at("requestTimeoutMs").get<int64_t>());
+        if (json.contains("minRequestTimeoutMs"))
+            admissionConfiguration.minRequestTimeout = std::chrono::milliseconds(json.at("minRequestTimeoutMs").get<int64_t>());
+        if (json.contains("deadlineHeader"))
+            json.at("deadlineHeader").get_to(admissionConfiguration.deadlineHeader);
+        if (json.contains("initialLimit"))
+            json.at("initialLimit").get_to(admissionConfiguration.initialLimit);
+        if (json.contains("minLimit"))
+            json.at("minLimit").get_to(admissionConfiguration.minLimit);
+        if (json.contains("maxLimit"))
+            json.at("maxLimit").get_to(admissionConfiguration.maxLimit);
+        if (json.contains("sampleWindow"))
+            json.at("sampleWindow").get_to(admissionConfiguration.sampleWindow);
+        if (json.contains("latencyTolerance"))
+            json.at("latencyTolerance").get_to(admissionConfiguration.latencyTolerance);
+        if (json.contains("smoothing"))
+            json.at("smoothing").get_to(admissionConfiguration.smoothing);
+        if (json.contains("retryAfterSeconds"))
+            admissionConfiguration.retryAfter = std::chrono::seconds(json.at("retryAfterSeconds").get<int64_t>());
+        if (json.contains("exemptPaths"))
+            json.at("exemptPaths").get_to(admissionConfiguration.exemptPaths);
+
+        if (admissionConfiguration.minRequestTimeout > admissionConfiguration.requestTimeout)
+            admissionConfiguration.minRequestTimeout = admissionConfiguration.requestTimeout;
+        if (admissionConfiguration.maxLimit < admissionConfiguration.minLimit)
+            admissionConfiguration.maxLimit = admissionConfiguration.minLimit;
+    }
+}
+#endif
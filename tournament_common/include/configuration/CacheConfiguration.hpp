@@ -0,0 +1,20 @@
+#ifndef CACHE_CONFIGURATION_HPP
+#define CACHE_CONFIGURATION_HPP
+
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    struct CacheConfiguration {
+        size_t capacity = 10000;
+        std::chrono::milliseconds ttl{std::chrono::minutes(5)};
+    };
+
+    inline void from_json(const nlohmann::json& json, CacheConfiguration& cacheConfiguration) {
+        if (json.contains("capacity"))
+            json.at("capacity").get_to(cacheConfiguration.capacity);
+        if (json.contains("ttlMs"))
+            cacheConfiguration.ttl = std::chrono::milliseconds(json.at("ttlMs").get<int64_t>());
+    }
+}
+#endif
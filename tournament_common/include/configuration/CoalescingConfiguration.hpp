@@ -0,0 +1,22 @@
+#ifndef COALESCING_CONFIGURATION_HPP
+#define COALESCING_CONFIGURATION_HPP
+
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    struct CoalescingConfiguration {
+        // how long the first reader of a batch waits for other ids before querying, 0 only shares identical reads
+        std::chrono::microseconds batchWindow{500};
+        // a batch this large is queried right away without waiting for the rest of the window
+        size_t maxBatchSize = 64;
+    };
+
+    inline void from_json(const nlohmann::json& json, CoalescingConfiguration& coalescingConfiguration) {
+        if (json.contains("batchWindowUs"))
+            coalescingConfiguration.batchWindow = std::chrono::microseconds(json.at("batchWindowUs").get<int64_t>());
+        if (json.contains("maxBatchSize"))
+            json.at("maxBatchSize").get_to(coalescingConfiguration.maxBatchSize);
+    }
+}
+#endif
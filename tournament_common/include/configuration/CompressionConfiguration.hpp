@@ -0,0 +1,23 @@
+#ifndef COMPRESSION_CONFIGURATION_HPP
+#define COMPRESSION_CONFIGURATION_HPP
+
+#include <nlohmann/json.hpp>
+
+namespace config {
+    struct CompressionConfiguration {
+        // bodies smaller than this go out as they are, the headers would eat most of the gain
+        size_t minSize = 1024;
+        int gzipLevel = 6;
+        int zstdLevel = 3;
+    };
+
+    inline void from_json(const nlohmann::json& json, CompressionConfiguration& compressionConfiguration) {
+        if (json.contains("minSize"))
+            json.at("minSize").get_to(compressionConfiguration.minSize);
+        if (json.contains("gzipLevel"))
+            json.at("gzipLevel").get_to(compressionConfiguration.gzipLevel);
+        if (json.contains("zstdLevel"))
+            json.at("zstdLevel").get_to(compressionConfiguration.zstdLevel);
+    }
+}
+#endif
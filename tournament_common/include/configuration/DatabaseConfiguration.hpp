@@ -2,14 +2,98 @@
 #define DATA_BASE_CONFIGURATION_HPP
 
 #include <string>
+#include <chrono>
+#include <optional>
+#include <nlohmann/json.hpp>
 
 namespace config {
+    // pool serving read_transactions, on the primary or on a streaming replica
+    struct ReadPoolConfiguration {
+        // empty reads from the primary through a pool of its own
+        std::string connectionString;
+        size_t minPoolSize = 1;
+        size_t maxPoolSize = 1;
+        // reads go back to the primary while the replica is further behind than this
+        std::chrono::milliseconds maxReplicaLag{1000};
+        std::chrono::milliseconds lagCheckInterval{1000};
+    };
+
+    inline void from_json(const nlohmann::json& json, ReadPoolConfiguration& readPoolConfiguration) {
+        if (json.contains("connectionString"))
+            json.at("connectionString").get_to(readPoolConfiguration.connectionString);
+        if (json.contains("minPoolSize"))
+            json.at("minPoolSize").get_to(readPoolConfiguration.minPoolSize);
+        if (json.contains("maxPoolSize"))
+            json.at("maxPoolSize").get_to(readPoolConfiguration.maxPoolSize);
+        if (json.contains("maxReplicaLagMs"))
+            readPoolConfiguration.maxReplicaLag = std::chrono::milliseconds(json.at("maxReplicaLagMs").get<int64_t>());
+        if (json.contains("lagCheckIntervalMs"))
+            readPoolConfiguration.lagCheckInterval = std::chrono::milliseconds(json.at("lagCheckIntervalMs").get<int64_t>());
+
+        if (readPoolConfiguration.maxPoolSize < readPoolConfiguration.minPoolSize)
+            readPoolConfiguration.maxPoolSize = readPoolConfiguration.minPoolSize;
+    }
+
+    // event loops multiplexing the async reads over pipelined connections of their own to the primary
+    struct AsyncConfiguration {
+        size_t eventLoops = 1;
+        size_t connectionsPerLoop = 2;
+        // queries in flight on a connection before the loop holds new ones back
+        size_t maxInFlightPerConnection = 64;
+    };
+
+    inline void from_json(const nlohmann::json& json, AsyncConfiguration& asyncConfiguration) {
+        if (json.contains("eventLoops"))
+            json.at("eventLoops").get_to(asyncConfiguration.eventLoops);
+        if (json.contains("connectionsPerLoop"))
+            json.at("connectionsPerLoop").get_to(asyncConfiguration.connectionsPerLoop);
+        if (json.contains("maxInFlightPerConnection"))
+            json.at("maxInFlightPerConnection").get_to(asyncConfiguration.maxInFlightPerConnection);
+    }
+
     struct DatabaseConfiguration{
         std::string connectionString;
+        size_t minPoolSize = 1;
+        size_t maxPoolSize = 1;
+        // warmed connections needed before the pool reports ready, defaults to minPoolSize
+        size_t readyPoolSize = 1;
+        // 0 picks one shard per hardware thread, capped by maxPoolSize
+        size_t poolShards = 0;
+        std::chrono::milliseconds acquireTimeout{5000};
+        // session statement_timeout of every pooled connection, 0 keeps the server's; requests with less time
+        // left than this lower it for their own transaction
+        std::chrono::milliseconds statementTimeout{0};
+        // without a read pool reads share the write pool
+        std::optional<ReadPoolConfiguration> readPool;
+        AsyncConfiguration async;
     };
 
     inline void from_json(const nlohmann::json& json, DatabaseConfiguration& databaseConfiguration) {
         json.at("connectionString").get_to(databaseConfiguration.connectionString);
+        if (json.contains("poolSize")) {
+            json.at("poolSize").get_to(databaseConfiguration.minPoolSize);
+            databaseConfiguration.maxPoolSize = databaseConfiguration.minPoolSize;
+        }
+        if (json.contains("minPoolSize"))
+            json.at("minPoolSize").get_to(databaseConfiguration.minPoolSize);
+        if (json.contains("maxPoolSize"))
+            json.at("maxPoolSize").get_to(databaseConfiguration.maxPoolSize);
+        databaseConfiguration.readyPoolSize = json.contains("readyPoolSize")
+            ? json.at("readyPoolSize").get<size_t>()
+            : databaseConfiguration.minPoolSize;
+        if (json.contains("poolShards"))
+            json.at("poolShards").get_to(databaseConfiguration.poolShards);
+        if (json.contains("acquireTimeoutMs"))
+            databaseConfiguration.acquireTimeout = std::chrono::milliseconds(json.at("acquireTimeoutMs").get<int64_t>());
+        if (json.contains("statementTimeoutMs"))
+            databaseConfiguration.statementTimeout = std::chrono::milliseconds(json.at("statementTimeoutMs").get<int64_t>());
+        if (json.contains("readPool"))
+            databaseConfiguration.readPool = json.at("readPool").get<ReadPoolConfiguration>();
+        if (json.contains("async"))
+            json.at("async").get_to(databaseConfiguration.async);
+
+        if (databaseConfiguration.maxPoolSize < databaseConfiguration.minPoolSize)
+            databaseConfiguration.maxPoolSize = databaseConfiguration.minPoolSize;
     }
 }
 #endif
@@ -0,0 +1,21 @@
+#ifndef METRICS_CONFIGURATION_HPP
+#define METRICS_CONFIGURATION_HPP
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    // scrape endpoint of processes that do not serve HTTP otherwise
+    struct MetricsConfiguration {
+        uint16_t port = 9101;
+        bool enabled = true;
+    };
+
+    inline void from_json(const nlohmann::json& json, MetricsConfiguration& metricsConfiguration) {
+        if (json.contains("port"))
+            json.at("port").get_to(metricsConfiguration.port);
+        if (json.contains("enabled"))
+            json.at("enabled").get_to(metricsConfiguration.enabled);
+    }
+}
+#endif
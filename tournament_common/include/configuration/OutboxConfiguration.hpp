@@ -0,0 +1,22 @@
+#ifndef OUTBOX_CONFIGURATION_HPP
+#define OUTBOX_CONFIGURATION_HPP
+
+#include <chrono>
+#include <nlohmann/json.hpp>
+
+namespace config {
+    struct OutboxConfiguration {
+        // messages published and deleted per relay transaction
+        size_t batchSize = 100;
+        // wait between polls while the outbox is empty, a full batch is followed by the next one right away
+        std::chrono::milliseconds pollInterval{100};
+    };
+
+    inline void from_json(const nlohmann::json& json, OutboxConfiguration& outboxConfiguration) {
+        if (json.contains("batchSize"))
+            json.at("batchSize").get_to(outboxConfiguration.batchSize);
+        if (json.contains("pollIntervalMs"))
+            outboxConfiguration.pollInterval = std::chrono::milliseconds(json.at("pollIntervalMs").get<int64_t>());
+    }
+}
+#endif
@@ -0,0 +1,34 @@
+#ifndef COMMON_STARTUP_REPORT_HPP
+#define COMMON_STARTUP_REPORT_HPP
+
+#include <chrono>
+#include <mutex>
+#include <print>
+#include <string_view>
+
+namespace config {
+    /**
+     * Prints when each startup phase finished, relative to the first use of the report, which
+     * main makes before anything else. Phases that complete in the background (pool warm-up,
+     * broker connection) mark themselves from their own threads.
+     */
+    class StartupReport {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::mutex mutex;
+
+        StartupReport() = default;
+    public:
+        static StartupReport& Instance() {
+            static StartupReport report;
+            return report;
+        }
+
+        void Mark(const std::string_view phase) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            std::lock_guard lock(mutex);
+            std::println("startup: {} after {}", phase, elapsed);
+        }
+    };
+}
+
+#endif //COMMON_STARTUP_REPORT_HPP
@@ -9,24 +9,24 @@
 namespace domain {
     class Group {
         /* data */
-        std::string id;
+        domain::Id id;
         std::string name;
-        std::string tournamentId;
+        domain::Id tournamentId;
         std::vector<Team> teams;
 
     public:
-        explicit Group(const std::string_view & name = "", const std::string_view&  id = "") : id(id), name(name) {
+        explicit Group(const std::string_view & name = "", const domain::Id& id = {}) : id(id), name(name) {
         }
 
-        [[nodiscard]] std::string Id() const {
+        [[nodiscard]] const domain::Id& Id() const {
             return  id;
         }
 
-        std::string& Id() {
+        domain::Id& Id() {
             return  id;
         }
 
-        [[nodiscard]] std::string Name() const {
+        [[nodiscard]] const std::string& Name() const {
             return  name;
         }
 
@@ -34,15 +34,15 @@ namespace domain {
             return  name;
         }
 
-        [[nodiscard]] std::string TournamentId() const {
+        [[nodiscard]] const domain::Id& TournamentId() const {
             return  tournamentId;
         }
 
-        [[nodiscard]] std::string & TournamentId() {
+        [[nodiscard]] domain::Id & TournamentId() {
             return  tournamentId;
         }
 
-        [[nodiscard]] std::vector<Team> Teams() const {
+        [[nodiscard]] const std::vector<Team>& Teams() const {
             return this->teams;
         }
 
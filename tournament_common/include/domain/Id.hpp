@@ -0,0 +1,127 @@
+#ifndef DOMAIN_ID_HPP
+#define DOMAIN_ID_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace domain {
+    /**
+     * UUID held as its 16 bytes. Trivially copyable, so it travels by value without touching the
+     * heap, and it converts to and from the canonical 8-4-4-4-12 text only at the edges (routes,
+     * JSON, text protocol queries). The default value is the nil UUID and stands for "no id yet".
+     */
+    class Id {
+        std::array<uint8_t, 16> bytes{};
+
+        static constexpr std::string_view HEX = "0123456789abcdef";
+        // offsets of the dashes in the text form
+        static constexpr std::array<size_t, 4> DASHES{8, 13, 18, 23};
+
+        static constexpr int HexValue(const char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+    public:
+        static constexpr size_t TEXT_SIZE = 36;
+
+        constexpr Id() = default;
+        constexpr explicit Id(const std::array<uint8_t, 16>& bytes) : bytes(bytes) {}
+
+        // canonical 36 character form, either case; nullopt for anything else
+        static constexpr std::optional<Id> Parse(const std::string_view text) {
+            if (text.size() != TEXT_SIZE) {
+                return std::nullopt;
+            }
+            Id id;
+            size_t position = 0;
+            for (size_t i = 0; i < id.bytes.size(); i++) {
+                if (position == DASHES[0] || position == DASHES[1] || position == DASHES[2] || position == DASHES[3]) {
+                    if (text[position] != '-') {
+                        return std::nullopt;
+                    }
+                    position++;
+                }
+                const int high = HexValue(text[position]);
+                const int low = HexValue(text[position + 1]);
+                if (high < 0 || low < 0) {
+                    return std::nullopt;
+                }
+                id.bytes[i] = static_cast<uint8_t>(high << 4 | low);
+                position += 2;
+            }
+            return id;
+        }
+
+        // lowercase canonical form, the one Postgres prints
+        [[nodiscard]] constexpr std::array<char, TEXT_SIZE> Chars() const {
+            std::array<char, TEXT_SIZE> text{};
+            size_t position = 0;
+            for (size_t i = 0; i < bytes.size(); i++) {
+                if (position == DASHES[0] || position == DASHES[1] || position == DASHES[2] || position == DASHES[3]) {
+                    text[position++] = '-';
+                }
+                text[position++] = HEX[bytes[i] >> 4];
+                text[position++] = HEX[bytes[i] & 0xF];
+            }
+            return text;
+        }
+
+        [[nodiscard]] std::string ToString() const {
+            const auto text = Chars();
+            return {text.data(), text.size()};
+        }
+
+        [[nodiscard]] constexpr bool IsNil() const {
+            for (const auto byte : bytes) {
+                if (byte != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] constexpr const std::array<uint8_t, 16>& Bytes() const {
+            return bytes;
+        }
+
+        friend constexpr bool operator==(const Id&, const Id&) = default;
+        friend constexpr auto operator<=>(const Id&, const Id&) = default;
+    };
+
+    static_assert(sizeof(Id) == 16);
+    static_assert(std::is_trivially_copyable_v<Id>);
+    static_assert(Id::Parse("3F1C2A9E-6B7D-4C1E-9A55-0D2F8E7B4C10")->Chars()[0] == '3');
+}
+
+template<>
+struct std::hash<domain::Id> {
+    size_t operator()(const domain::Id& id) const noexcept {
+        // random UUIDs are already uniform, folding both halves is enough
+        uint64_t high = 0, low = 0;
+        for (size_t i = 0; i < 8; i++) {
+            high = high << 8 | id.Bytes()[i];
+            low = low << 8 | id.Bytes()[i + 8];
+        }
+        return static_cast<size_t>(high ^ low);
+    }
+};
+
+template<>
+struct std::formatter<domain::Id> : std::formatter<std::string_view> {
+    auto format(const domain::Id& id, std::format_context& context) const {
+        const auto text = id.Chars();
+        return std::formatter<std::string_view>::format(std::string_view(text.data(), text.size()), context);
+    }
+};
+
+#endif //DOMAIN_ID_HPP
@@ -0,0 +1,259 @@
+#ifndef DOMAIN_JSON_SERIALIZER_HPP
+#define DOMAIN_JSON_SERIALIZER_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+
+#include "domain/Utilities.hpp"
+
+/**
+ * Writes domain objects as JSON straight into one string, without building an nlohmann::json
+ * DOM first. Each type describes its fields once in JsonFields<Type>, in the sorted key order
+ * nlohmann::json dumps them in. The to_json overloads for the stored documents are built from
+ * the same fields, so both outputs match byte for byte.
+ */
+namespace domain {
+    class JsonWriter {
+        std::string buffer;
+    public:
+        explicit JsonWriter(const size_t reserve) {
+            buffer.reserve(reserve);
+        }
+
+        void Raw(const char value) { buffer.push_back(value); }
+        void Raw(const std::string_view value) { buffer.append(value); }
+
+        void Number(const int64_t value) {
+            std::array<char, 24> digits{};
+            const auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+            buffer.append(digits.data(), end);
+        }
+
+        // escapes like nlohmann::json::dump, multibyte UTF-8 passes through untouched
+        void String(const std::string_view value) {
+            static constexpr std::string_view HEX = "0123456789abcdef";
+            buffer.push_back('"');
+            size_t start = 0;
+            for (size_t i = 0; i < value.size(); i++) {
+                const auto c = static_cast<unsigned char>(value[i]);
+                if (c >= 0x20 && c != '"' && c != '\\') {
+                    continue;
+                }
+                buffer.append(value.substr(start, i - start));
+                switch (c) {
+                    case '"': buffer.append("\\\""); break;
+                    case '\\': buffer.append("\\\\"); break;
+                    case '\b': buffer.append("\\b"); break;
+                    case '\f': buffer.append("\\f"); break;
+                    case '\n': buffer.append("\\n"); break;
+                    case '\r': buffer.append("\\r"); break;
+                    case '\t': buffer.append("\\t"); break;
+                    default:
+                        buffer.append("\\u00");
+                        buffer.push_back(HEX[c >> 4]);
+                        buffer.push_back(HEX[c & 0xF]);
+                }
+                start = i + 1;
+            }
+            buffer.append(value.substr(start));
+            buffer.push_back('"');
+        }
+
+        std::string Take() { return std::move(buffer); }
+    };
+
+    template<typename Getter>
+    struct JsonField {
+        std::string_view key;
+        Getter get;
+        // skipped when the value is empty, e.g. the id of an entity not stored yet
+        bool omitEmpty = false;
+    };
+
+    template<typename Type>
+    struct JsonFields;
+
+    template<>
+    struct JsonFields<Team> {
+        static constexpr auto FIELDS = std::tuple{
+            JsonField{"id", [](const Team& team) -> const Id& { return team.Id; }, true},
+            JsonField{"name", [](const Team& team) -> const std::string& { return team.Name; }},
+        };
+    };
+
+    template<>
+    struct JsonFields<TournamentFormat> {
+        static constexpr auto FIELDS = std::tuple{
+            JsonField{"maxTeamsPerGroup", [](const TournamentFormat& format) { return format.MaxTeamsPerGroup(); }},
+            JsonField{"numberOfGroups", [](const TournamentFormat& format) { return format.NumberOfGroups(); }},
+            JsonField{"type", [](const TournamentFormat& format) { return toString(format.Type()); }},
+        };
+    };
+
+    template<>
+    struct JsonFields<Tournament> {
+        static constexpr auto FIELDS = std::tuple{
+            JsonField{"format", [](const Tournament& tournament) -> const TournamentFormat& { return tournament.Format(); }},
+            JsonField{"id", [](const Tournament& tournament) -> const Id& { return tournament.Id(); }, true},
+            JsonField{"name", [](const Tournament& tournament) -> const std::string& { return tournament.Name(); }},
+        };
+    };
+
+    template<>
+    struct JsonFields<Group> {
+        static constexpr auto FIELDS = std::tuple{
+            JsonField{"id", [](const Group& group) -> const Id& { return group.Id(); }, true},
+            JsonField{"name", [](const Group& group) -> const std::string& { return group.Name(); }},
+            JsonField{"teams", [](const Group& group) -> const std::vector<Team>& { return group.Teams(); }},
+            JsonField{"tournamentId", [](const Group& group) -> const Id& { return group.TournamentId(); }},
+        };
+    };
+
+    template<>
+    struct JsonFields<Score> {
+        static constexpr auto FIELDS = std::tuple{
+            JsonField{"homeTeamScore", [](const Score& score) { return score.homeTeamScore; }},
+            JsonField{"visitorTeamScore", [](const Score& score) { return score.visitorTeamScore; }},
+        };
+    };
+
+    template<>
+    struct JsonFields<Match> {
+        static constexpr auto FIELDS = std::tuple{
+            JsonField{"homeTeamId", [](const Match& match) -> const Id& { return match.HomeTeamId(); }},
+            JsonField{"id", [](const Match& match) -> const Id& { return match.Id(); }, true},
+            JsonField{"round", [](const Match& match) { return match.Round(); }},
+            JsonField{"score", [](const Match& match) -> const Score& { return match.MatchScore(); }},
+            JsonField{"tournamentId", [](const Match& match) -> const Id& { return match.TournamentId(); }},
+            JsonField{"visitorTeamId", [](const Match& match) -> const Id& { return match.VisitorTeamId(); }, true},
+        };
+    };
+
+    template<typename Type>
+    consteval bool KeysSorted() {
+        return std::apply([](const auto&... field) {
+            const std::array<std::string_view, sizeof...(field)> keys{field.key...};
+            return std::ranges::is_sorted(keys);
+        }, JsonFields<Type>::FIELDS);
+    }
+
+    template<typename Type>
+    struct IsSharedPtr : std::false_type {};
+    template<typename Type>
+    struct IsSharedPtr<std::shared_ptr<Type>> : std::true_type {};
+
+    template<typename Type>
+    concept HasJsonFields = requires { JsonFields<Type>::FIELDS; };
+
+    template<typename Field, typename Member>
+    bool IsOmitted(const Field& field, const Member& member) {
+        if constexpr (std::is_same_v<Member, Id>) {
+            return field.omitEmpty && member.IsNil();
+        } else if constexpr (requires { member.empty(); }) {
+            return field.omitEmpty && member.empty();
+        } else {
+            return false;
+        }
+    }
+
+    template<typename Type>
+    void WriteJson(JsonWriter& writer, const Type& value);
+
+    template<typename Type, typename Field>
+    void WriteJsonField(JsonWriter& writer, const Type& value, const Field& field, bool& first) {
+        decltype(auto) member = field.get(value);
+        if (IsOmitted(field, member)) {
+            return;
+        }
+        if (!first) {
+            writer.Raw(',');
+        }
+        first = false;
+        writer.String(field.key);
+        writer.Raw(':');
+        WriteJson(writer, member);
+    }
+
+    template<typename Type>
+    void WriteJson(JsonWriter& writer, const Type& value) {
+        if constexpr (std::is_convertible_v<const Type&, std::string_view>) {
+            writer.String(value);
+        } else if constexpr (std::is_same_v<Type, Id>) {
+            if (value.IsNil()) {
+                writer.String(std::string_view());
+            } else {
+                const auto text = value.Chars();
+                writer.String(std::string_view(text.data(), text.size()));
+            }
+        } else if constexpr (std::is_same_v<Type, bool>) {
+            writer.Raw(value ? std::string_view("true") : std::string_view("false"));
+        } else if constexpr (std::is_integral_v<Type>) {
+            writer.Number(value);
+        } else if constexpr (IsSharedPtr<Type>::value) {
+            if (value == nullptr) {
+                writer.Raw("null");
+            } else {
+                WriteJson(writer, *value);
+            }
+        } else if constexpr (std::ranges::range<Type>) {
+            writer.Raw('[');
+            bool first = true;
+            for (const auto& element : value) {
+                if (!first) {
+                    writer.Raw(',');
+                }
+                first = false;
+                WriteJson(writer, element);
+            }
+            writer.Raw(']');
+        } else {
+            static_assert(KeysSorted<Type>(), "JsonFields keys must be sorted to match nlohmann::json output");
+            writer.Raw('{');
+            bool first = true;
+            std::apply([&](const auto&... field) { (WriteJsonField(writer, value, field, first), ...); }, JsonFields<Type>::FIELDS);
+            writer.Raw('}');
+        }
+    }
+
+    // reserve is a hint for the output size, a good guess saves the buffer from growing
+    template<typename Type>
+    std::string ToJson(const Type& value, const size_t reserve = 256) {
+        JsonWriter writer(reserve);
+        WriteJson(writer, value);
+        return writer.Take();
+    }
+
+    // found by nlohmann::json through ADL, for the documents the repositories store
+    template<HasJsonFields Type>
+    void to_json(nlohmann::json& json, const Type& value) {
+        json = nlohmann::json::object();
+        std::apply([&](const auto&... field) {
+            ([&] {
+                decltype(auto) member = field.get(value);
+                if (!IsOmitted(field, member)) {
+                    json[field.key] = member;
+                }
+            }(), ...);
+        }, JsonFields<Type>::FIELDS);
+    }
+
+    template<HasJsonFields Type>
+    void to_json(nlohmann::json& json, const std::shared_ptr<Type>& value) {
+        if (value == nullptr) {
+            json = nullptr;
+        } else {
+            to_json(json, *value);
+        }
+    }
+}
+
+#endif //DOMAIN_JSON_SERIALIZER_HPP
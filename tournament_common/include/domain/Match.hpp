@@ -2,11 +2,14 @@
 #define DOMAIN_MATCH_HPP
 
 #include <string>
+
+#include "domain/Id.hpp"
+
 namespace domain {
     enum class Winner { HOME, VISITOR  };
     struct Score {
-        int homeTeamScore;
-        int visitorTeamScore;
+        int homeTeamScore = 0;
+        int visitorTeamScore = 0;
         [[nodiscard]] Winner GetWinner() const {
             if (visitorTeamScore < homeTeamScore) {
                 return Winner::HOME;
@@ -15,9 +18,12 @@ namespace domain {
         }
     };
     class Match {
-        /* data */
-        std::string homeTeamId;
-        std::string visitorTeamId;
+        domain::Id id;
+        domain::Id tournamentId;
+        // 1 based position of the match in the tournament's schedule
+        int round = 1;
+        domain::Id homeTeamId;
+        domain::Id visitorTeamId;
         Score score;
 
         //winner's next match
@@ -25,18 +31,40 @@ namespace domain {
 
     public:
         Match(/* args */){}
-        [[nodiscard]] std::string HomeTeamId() const {
+
+        [[nodiscard]] const domain::Id& Id() const {
+            return id;
+        }
+        domain::Id & Id() {
+            return id;
+        }
+
+        [[nodiscard]] const domain::Id& TournamentId() const {
+            return tournamentId;
+        }
+        domain::Id & TournamentId() {
+            return tournamentId;
+        }
+
+        [[nodiscard]] int Round() const {
+            return round;
+        }
+        int & Round() {
+            return round;
+        }
+
+        [[nodiscard]] const domain::Id& HomeTeamId() const {
             return homeTeamId;
         }
-        std::string & HomeTeamId() {
+        domain::Id & HomeTeamId() {
             return homeTeamId;
         }
 
-        [[nodiscard]] std::string VisitorTeamId() const {
+        [[nodiscard]] const domain::Id& VisitorTeamId() const {
             return visitorTeamId;
         }
 
-        std::string & VisitorTeamId() {
+        domain::Id & VisitorTeamId() {
             return visitorTeamId;
         }
 
@@ -44,9 +72,14 @@ namespace domain {
             return score;
         }
 
-        [[nodiscard]] Score MatchScore() const {
+        [[nodiscard]] const Score& MatchScore() const {
             return score;
         }
+
+        // waiting for its visitor team
+        [[nodiscard]] bool IsOpen() const {
+            return visitorTeamId.IsNil();
+        }
     };
     
 }
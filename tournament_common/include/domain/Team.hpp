@@ -4,12 +4,17 @@
 
 #ifndef RESTAPI_DOMAIN_TEAM_HPP
 #define RESTAPI_DOMAIN_TEAM_HPP
+#include <chrono>
 #include <string>
 
+#include "domain/Id.hpp"
+
 namespace domain {
     struct Team {
-        std::string Id;
+        domain::Id Id;
         std::string Name;
+        // last_update_date of the row, only set on teams read by id so it is cached with them
+        std::chrono::sys_time<std::chrono::microseconds> LastModified{};
     };
 }
-#endif //RESTAPI_DOMAIN_TEAM_HPP
\ No newline at end of file
+#endif //RESTAPI_DOMAIN_TEAM_HPP
@@ -49,7 +49,7 @@ namespace domain {
 
     class Tournament
     {
-        std::string id;
+        domain::Id id;
         std::string name;
         TournamentFormat format;
         std::vector<Group> groups;
@@ -61,15 +61,15 @@ namespace domain {
             this->format = format;
         }
 
-        [[nodiscard]] std::string Id() const {
+        [[nodiscard]] const domain::Id& Id() const {
             return this->id;
         }
 
-        std::string& Id() {
+        domain::Id& Id() {
             return this->id;
         }
 
-        [[nodiscard]] std::string Name() const {
+        [[nodiscard]] const std::string& Name() const {
             return this->name;
         }
 
@@ -77,7 +77,7 @@ namespace domain {
             return this->name;
         }
 
-        [[nodiscard]] TournamentFormat Format() const {
+        [[nodiscard]] const TournamentFormat& Format() const {
             return this->format;
         }
 
@@ -89,7 +89,7 @@ namespace domain {
             return this->groups;
         }
 
-        [[nodiscard]] std::vector<Match> Matches() const {
+        [[nodiscard]] const std::vector<Match>& Matches() const {
             return this->matches;
         }
     };
@@ -1,6 +1,8 @@
 #ifndef DOMAIN_UTILITIES_HPP
 #define DOMAIN_UTILITIES_HPP
 
+#include <format>
+#include <stdexcept>
 #include <nlohmann/json.hpp>
 #include "domain/Team.hpp"
 #include "domain/Tournament.hpp"
@@ -9,8 +11,22 @@
 
 namespace domain {
 
-    inline void to_json(nlohmann::json& json, const Team& team) {
-        json = {{"id", team.Id}, {"name", team.Name}};
+    // the nil id is written as "", like the empty string ids were before
+    inline void to_json(nlohmann::json& json, const Id& id) {
+        json = id.IsNil() ? std::string() : id.ToString();
+    }
+
+    inline void from_json(const nlohmann::json& json, Id& id) {
+        const auto& text = json.get_ref<const std::string&>();
+        if (text.empty()) {
+            id = Id{};
+            return;
+        }
+        const auto parsed = Id::Parse(text);
+        if (!parsed) {
+            throw std::invalid_argument(std::format("invalid id {}", text));
+        }
+        id = *parsed;
     }
 
     inline void from_json(const nlohmann::json& json, Team& team) {
@@ -33,15 +49,6 @@ namespace domain {
         }
     }
 
-    inline void to_json(nlohmann::json& json, const std::shared_ptr<Team>& team) {
-        json = nlohmann::basic_json();
-        json["name"] = team->Name;
-
-        if (!team->Id.empty()) {
-            json["id"] = team->Id;
-        }
-    }
-
     inline TournamentType fromString(std::string_view type) {
         if (type == "ROUND_ROBIN")
             return TournamentType::ROUND_ROBIN;
@@ -60,48 +67,28 @@ namespace domain {
             format.Type() = fromString(json["type"].get<std::string>());
     }
 
-    inline void to_json(nlohmann::json& json, const TournamentFormat& format) {
-        json = {{"maxTeamsPerGroup", format.MaxTeamsPerGroup()}, {"numberOfGroups", format.NumberOfGroups()}};
-        switch (format.Type()) {
-            case TournamentType::ROUND_ROBIN:
-                json["type"] = "ROUND_ROBIN";
-                break;
+    inline std::string_view toString(const TournamentType type) {
+        switch (type) {
             case TournamentType::NFL:
-                json["type"] = "NFL";
-                break;
+                return "NFL";
+            case TournamentType::ROUND_ROBIN:
             default:
-                json["type"] = "ROUND_ROBIN";
-        }
-    }
-
-    inline void to_json(nlohmann::json& json, const std::shared_ptr<Tournament>& tournament) {
-        json = {{"name", tournament->Name()}};
-        if (!tournament->Id().empty()) {
-            json["id"] = tournament->Id();
+                return "ROUND_ROBIN";
         }
-        json["format"] = tournament->Format();
     }
 
     inline void from_json(const nlohmann::json& json, std::shared_ptr<Tournament>& tournament) {
         if(json.contains("id")) {
-            tournament->Id() = json["id"].get<std::string>();
+            tournament->Id() = json["id"].get<Id>();
         }
         json["name"].get_to(tournament->Name());
         if (json.contains("format"))
             json.at("format").get_to(tournament->Format());
     }
 
-    inline void to_json(nlohmann::json& json, const Tournament& tournament) {
-        json = {{"name", tournament.Name()}};
-        if (!tournament.Id().empty()) {
-            json["id"] = tournament.Id();
-        }
-        json["format"] = tournament.Format();
-    }
-
     inline void from_json(const nlohmann::json& json, Tournament& tournament) {
         if(json.contains("id")) {
-            tournament.Id() = json["id"].get<std::string>();
+            tournament.Id() = json["id"].get<Id>();
         }
         json["name"].get_to(tournament.Name());
         if (json.contains("format"))
@@ -110,10 +97,10 @@ namespace domain {
 
     inline void from_json(const nlohmann::json& json, Group& group) {
         if(json.contains("id")) {
-            group.Id() = json["id"].get<std::string>();
+            group.Id() = json["id"].get<Id>();
         }
         if(json.contains("tournamentId")) {
-            group.TournamentId() = json["tournamentId"].get<std::string>();
+            group.TournamentId() = json["tournamentId"].get<Id>();
         }
         json["name"].get_to(group.Name());
         if (json.contains("teams")) {
@@ -121,36 +108,26 @@ namespace domain {
         }
     }
 
-    inline void to_json(nlohmann::json& json, const std::shared_ptr<Group>& group) {
-        json["name"] = group->Name();
-        json["tournamentId"] = group->TournamentId();
-        if (!group->Id().empty()) {
-            json["id"] = group->Id();
-        }
-        json["teams"] = group->Teams();
+    inline void from_json(const nlohmann::json& json, Score& score) {
+        score.homeTeamScore = json.value("homeTeamScore", 0);
+        score.visitorTeamScore = json.value("visitorTeamScore", 0);
     }
 
-    inline void to_json(nlohmann::json& json, const std::vector<std::shared_ptr<Group>>& groups) {
-        json = nlohmann::json::array();
-        for (const auto& group : groups) {
-            auto jsonGroup = nlohmann::json();
-            jsonGroup["name"] = group->Name();
-            jsonGroup["tournamentId"] = group->TournamentId();
-            if (!group->Id().empty()) {
-                jsonGroup["id"] = group->Id();
-            }
-            jsonGroup["teams"] = group->Teams();
-            json.push_back(jsonGroup);
+    inline void from_json(const nlohmann::json& json, Match& match) {
+        if (json.contains("id")) {
+            match.Id() = json["id"].get<Id>();
         }
-    }
-
-    inline void to_json(nlohmann::json& json, const Group& group) {
-        json["name"] = group.Name();
-        json["tournamentId"] = group.TournamentId();
-        if (!group.Id().empty()) {
-            json["id"] = group.Id();
+        if (json.contains("tournamentId")) {
+            match.TournamentId() = json["tournamentId"].get<Id>();
+        }
+        match.Round() = json.value("round", 1);
+        json["homeTeamId"].get_to(match.HomeTeamId());
+        if (json.contains("visitorTeamId")) {
+            json["visitorTeamId"].get_to(match.VisitorTeamId());
+        }
+        if (json.contains("score")) {
+            json["score"].get_to(match.MatchScore());
         }
-        json["teams"] = group.Teams();
     }
 }
 
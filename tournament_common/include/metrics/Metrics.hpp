@@ -0,0 +1,361 @@
+#ifndef TOURNAMENTS_METRICS_HPP
+#define TOURNAMENTS_METRICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Prometheus counters and histograms. Each metric is split in STRIPES cache-line sized stripes
+ * and every thread writes to its own with relaxed atomics, the way pool shards are picked, so
+ * recording on the hot path never contends; the stripes are only added up when /metrics is
+ * scraped. Series are created once, when their owner is set up, and kept by reference.
+ */
+namespace metrics {
+    inline constexpr size_t STRIPES = 16;
+    inline constexpr std::string_view CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+    // upper bounds of the latency buckets, 100us to 10s
+    inline constexpr std::array<std::chrono::nanoseconds, 16> LATENCY_BOUNDS{
+        std::chrono::microseconds(100), std::chrono::microseconds(250), std::chrono::microseconds(500),
+        std::chrono::milliseconds(1), std::chrono::microseconds(2500), std::chrono::milliseconds(5),
+        std::chrono::milliseconds(10), std::chrono::milliseconds(25), std::chrono::milliseconds(50),
+        std::chrono::milliseconds(100), std::chrono::milliseconds(250), std::chrono::milliseconds(500),
+        std::chrono::seconds(1), std::chrono::milliseconds(2500), std::chrono::seconds(5), std::chrono::seconds(10)
+    };
+
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    inline size_t ThreadStripe() {
+        static std::atomic<size_t> nextStripe{0};
+        thread_local const size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+        return stripe;
+    }
+
+    class Counter {
+        struct alignas(64) Stripe {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Stripe, STRIPES> stripes;
+    public:
+        void Increment(const uint64_t by = 1) {
+            stripes[ThreadStripe()].value.fetch_add(by, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] uint64_t Value() const {
+            uint64_t total = 0;
+            for (const auto& stripe : stripes) {
+                total += stripe.value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+    };
+
+    class Histogram {
+        struct alignas(64) Stripe {
+            // the last bucket takes everything slower than the last bound
+            std::array<std::atomic<uint64_t>, LATENCY_BOUNDS.size() + 1> buckets{};
+            std::atomic<uint64_t> sumNanos{0};
+        };
+        std::array<Stripe, STRIPES> stripes;
+    public:
+        struct Snapshot {
+            // per bucket, not cumulative
+            std::array<uint64_t, LATENCY_BOUNDS.size() + 1> buckets{};
+            uint64_t count = 0;
+            uint64_t sumNanos = 0;
+        };
+
+        void Observe(const std::chrono::nanoseconds elapsed) {
+            size_t bucket = 0;
+            while (bucket < LATENCY_BOUNDS.size() && elapsed > LATENCY_BOUNDS[bucket]) {
+                bucket++;
+            }
+            auto& stripe = stripes[ThreadStripe()];
+            stripe.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            stripe.sumNanos.fetch_add(static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count())), std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] Snapshot Read() const {
+            Snapshot snapshot;
+            for (const auto& stripe : stripes) {
+                for (size_t i = 0; i < stripe.buckets.size(); i++) {
+                    const uint64_t value = stripe.buckets[i].load(std::memory_order_relaxed);
+                    snapshot.buckets[i] += value;
+                    snapshot.count += value;
+                }
+                snapshot.sumNanos += stripe.sumNanos.load(std::memory_order_relaxed);
+            }
+            return snapshot;
+        }
+    };
+
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    class Registry;
+
+    // keeps a sampled series registered while its owner is alive
+    class Sampler {
+        Registry* registry = nullptr;
+        uint64_t id = 0;
+    public:
+        Sampler() = default;
+        Sampler(Registry* registry, const uint64_t id) : registry(registry), id(id) {}
+        Sampler(const Sampler&) = delete;
+        Sampler& operator=(const Sampler&) = delete;
+        Sampler(Sampler&& other) noexcept : registry(std::exchange(other.registry, nullptr)), id(other.id) {}
+        Sampler& operator=(Sampler&& other) noexcept;
+        ~Sampler();
+    };
+
+    /**
+     * Process wide catalog of metric families, rendered in the Prometheus text format. Asking
+     * twice for the same name and labels returns the same series.
+     */
+    class Registry {
+        struct Series {
+            Labels labels;
+            std::unique_ptr<Counter> counter;
+            std::unique_ptr<Histogram> histogram;
+            std::function<double()> sample;
+            uint64_t samplerId = 0;
+        };
+        struct Family {
+            std::string name;
+            std::string help;
+            Type type;
+            // deque keeps the references handed out valid
+            std::deque<Series> series;
+        };
+
+        mutable std::mutex mutex;
+        std::deque<Family> families;
+        uint64_t nextSamplerId = 1;
+
+        Registry() = default;
+
+        Family& FamilyFor(const std::string_view name, const std::string_view help, const Type type) {
+            for (auto& family : families) {
+                if (family.name == name) {
+                    // one name with two types would render as a family Prometheus rejects
+                    if (family.type != type) {
+                        throw std::logic_error("Metric " + family.name + " is already registered with another type");
+                    }
+                    return family;
+                }
+            }
+            return families.emplace_back(Family{std::string(name), std::string(help), type, {}});
+        }
+
+        static Series* Find(Family& family, const Labels& labels) {
+            for (auto& series : family.series) {
+                if (series.labels == labels && (series.counter || series.histogram || series.sample)) {
+                    return &series;
+                }
+            }
+            return nullptr;
+        }
+
+        static void AppendNumber(std::string& out, const double value) {
+            char buffer[64];
+            // plain decimals read better in bucket bounds, huge values fall back to the shortest form
+            auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed);
+            if (error != std::errc()) {
+                end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+            }
+            out.append(buffer, end);
+        }
+
+        static void AppendNumber(std::string& out, const uint64_t value) {
+            char buffer[24];
+            const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+            out.append(buffer, end);
+        }
+
+        static void AppendLabels(std::string& out, const Labels& labels, const std::string_view le = {}) {
+            if (labels.empty() && le.empty()) {
+                return;
+            }
+            out += '{';
+            bool first = true;
+            const auto append = [&out, &first](const std::string_view name, const std::string_view value) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                out.append(name);
+                out += "=\"";
+                for (const char c : value) {
+                    if (c == '\\' || c == '"') {
+                        out += '\\';
+                        out += c;
+                    } else if (c == '\n') {
+                        out += "\\n";
+                    } else {
+                        out += c;
+                    }
+                }
+                out += '"';
+            };
+            for (const auto& [name, value] : labels) {
+                append(name, value);
+            }
+            if (!le.empty()) {
+                append("le", le);
+            }
+            out += '}';
+        }
+
+        static void RenderHistogram(std::string& out, const std::string& name, const Series& series) {
+            const auto snapshot = series.histogram->Read();
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < snapshot.buckets.size(); i++) {
+                cumulative += snapshot.buckets[i];
+                std::string le;
+                if (i < LATENCY_BOUNDS.size()) {
+                    AppendNumber(le, std::chrono::duration<double>(LATENCY_BOUNDS[i]).count());
+                } else {
+                    le = "+Inf";
+                }
+                out += name;
+                out += "_bucket";
+                AppendLabels(out, series.labels, le);
+                out += ' ';
+                AppendNumber(out, cumulative);
+                out += '\n';
+            }
+            out += name;
+            out += "_sum";
+            AppendLabels(out, series.labels);
+            out += ' ';
+            AppendNumber(out, static_cast<double>(snapshot.sumNanos) / 1e9);
+            out += '\n';
+            out += name;
+            out += "_count";
+            AppendLabels(out, series.labels);
+            out += ' ';
+            AppendNumber(out, snapshot.count);
+            out += '\n';
+        }
+
+    public:
+        static Registry& Instance() {
+            static Registry registry;
+            return registry;
+        }
+
+        Counter& GetCounter(const std::string_view name, const std::string_view help, const Labels& labels = {}) {
+            std::lock_guard lock(mutex);
+            auto& family = FamilyFor(name, help, Type::COUNTER);
+            if (auto* series = Find(family, labels); series != nullptr && series->counter) {
+                return *series->counter;
+            }
+            return *family.series.emplace_back(Series{labels, std::make_unique<Counter>(), nullptr, {}, 0}).counter;
+        }
+
+        Histogram& GetHistogram(const std::string_view name, const std::string_view help, const Labels& labels = {}) {
+            std::lock_guard lock(mutex);
+            auto& family = FamilyFor(name, help, Type::HISTOGRAM);
+            if (auto* series = Find(family, labels); series != nullptr && series->histogram) {
+                return *series->histogram;
+            }
+            return *family.series.emplace_back(Series{labels, nullptr, std::make_unique<Histogram>(), {}, 0}).histogram;
+        }
+
+        // value read on every scrape, for levels or for counters kept elsewhere; a later sampler with the same
+        // labels takes the series over
+        [[nodiscard]] Sampler Sample(const std::string_view name, const std::string_view help, const Type type, const Labels& labels, std::function<double()> sample) {
+            std::lock_guard lock(mutex);
+            auto& family = FamilyFor(name, help, type);
+            const uint64_t id = nextSamplerId++;
+            if (auto* series = Find(family, labels); series != nullptr && series->sample) {
+                series->sample = std::move(sample);
+                series->samplerId = id;
+            } else {
+                family.series.emplace_back(Series{labels, nullptr, nullptr, std::move(sample), id});
+            }
+            return {this, id};
+        }
+
+        void Remove(const uint64_t samplerId) {
+            std::lock_guard lock(mutex);
+            for (auto& family : families) {
+                for (auto& series : family.series) {
+                    if (series.samplerId == samplerId) {
+                        // the slot stays so references to other series remain valid
+                        series.sample = nullptr;
+                        series.samplerId = 0;
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] std::string Render() const {
+            std::string out;
+            std::lock_guard lock(mutex);
+            for (const auto& family : families) {
+                out += "# HELP ";
+                out += family.name;
+                out += ' ';
+                out += family.help;
+                out += "\n# TYPE ";
+                out += family.name;
+                out += family.type == Type::COUNTER ? " counter\n" : family.type == Type::GAUGE ? " gauge\n" : " histogram\n";
+                for (const auto& series : family.series) {
+                    if (series.histogram) {
+                        RenderHistogram(out, family.name, series);
+                        continue;
+                    }
+                    if (!series.counter && !series.sample) {
+                        continue;
+                    }
+                    out += family.name;
+                    AppendLabels(out, series.labels);
+                    out += ' ';
+                    if (series.counter) {
+                        AppendNumber(out, series.counter->Value());
+                    } else {
+                        AppendNumber(out, series.sample());
+                    }
+                    out += '\n';
+                }
+            }
+            return out;
+        }
+    };
+
+    inline Sampler& Sampler::operator=(Sampler&& other) noexcept {
+        if (this != &other) {
+            if (registry != nullptr) {
+                registry->Remove(id);
+            }
+            registry = std::exchange(other.registry, nullptr);
+            id = other.id;
+        }
+        return *this;
+    }
+
+    inline Sampler::~Sampler() {
+        if (registry != nullptr) {
+            registry->Remove(id);
+        }
+    }
+
+    inline std::chrono::nanoseconds Since(const std::chrono::steady_clock::time_point started) {
+        return std::chrono::steady_clock::now() - started;
+    }
+}
+
+#endif //TOURNAMENTS_METRICS_HPP
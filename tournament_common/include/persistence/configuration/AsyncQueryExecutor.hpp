@@ -0,0 +1,89 @@
+#ifndef TOURNAMENTS_ASYNCQUERYEXECUTOR_HPP
+#define TOURNAMENTS_ASYNCQUERYEXECUTOR_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "AsyncResult.hpp"
+#include "RequestDeadline.hpp"
+#include "StatementRegistry.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
+#include "domain/Id.hpp"
+
+// parameter of an async query, sent in text format unless it is a uuid
+struct AsyncParam {
+    std::optional<std::string> value;
+    bool binary = false;
+
+    AsyncParam(std::string text) : value(std::move(text)) {}
+    AsyncParam(const domain::Id& id)
+        : value(std::string(reinterpret_cast<const char*>(id.Bytes().data()), id.Bytes().size())), binary(true) {}
+};
+
+struct AsyncQuery {
+    PreparedStatement* statement;
+    std::vector<AsyncParam> params;
+    // queries still waiting to be sent past it fail without reaching the server, sent ones are cancelled by it
+    deadline::Clock::time_point deadline = deadline::Clock::time_point::max();
+};
+
+/**
+ * Runs registry statements without tying up the calling thread. A few event-loop threads each own
+ * connectionsPerLoop libpq connections in non-blocking pipeline mode, opened with PQconnectStart so
+ * a database that is down never blocks a loop. Queries are sent as soon as a connection has room,
+ * each one followed by its own sync so a failure only affects that query, and results are matched
+ * back in order as the socket becomes readable.
+ *
+ * A statement is prepared on a connection the first time it runs there, in the same round trip.
+ * The request deadline is applied as a statement_timeout local to the query, next to it in the
+ * pipeline. Callbacks run on the loop thread and must not block.
+ */
+class AsyncQueryExecutor {
+public:
+    using Callback = std::function<void(AsyncResult)>;
+
+private:
+    struct EventLoop;
+    config::DatabaseConfiguration configuration;
+    std::vector<std::unique_ptr<EventLoop>> loops;
+    std::atomic<size_t> nextLoop{0};
+
+public:
+    explicit AsyncQueryExecutor(const config::DatabaseConfiguration& configuration);
+    ~AsyncQueryExecutor();
+    AsyncQueryExecutor(const AsyncQueryExecutor&) = delete;
+    AsyncQueryExecutor& operator=(const AsyncQueryExecutor&) = delete;
+
+    void Submit(AsyncQuery query, Callback callback);
+};
+
+/**
+ * Runs the query and completes with what map makes of its rows, an exception thrown while mapping
+ * failing it as a QUERY error. Without an executor the completion gets UNAVAILABLE right away.
+ */
+template<typename Type, typename Map>
+void SubmitMapped(const std::shared_ptr<AsyncQueryExecutor>& executor, AsyncQuery query, AsyncCompletion<Type> completion, Map map) {
+    if (executor == nullptr) {
+        completion(std::unexpected(AsyncError{AsyncError::Kind::UNAVAILABLE, "async queries are not enabled"}));
+        return;
+    }
+    executor->Submit(std::move(query), [completion = std::move(completion), map = std::move(map)](AsyncResult result) {
+        std::expected<Type, AsyncError> mapped = std::unexpected(AsyncError{});
+        if (!result) {
+            mapped = std::unexpected(std::move(result.error()));
+        } else {
+            try {
+                mapped = map(*result);
+            } catch (const std::exception& e) {
+                mapped = std::unexpected(AsyncError{AsyncError::Kind::QUERY, e.what()});
+            }
+        }
+        completion(std::move(mapped));
+    });
+}
+
+#endif //TOURNAMENTS_ASYNCQUERYEXECUTOR_HPP
@@ -0,0 +1,108 @@
+#ifndef TOURNAMENTS_ASYNCRESULT_HPP
+#define TOURNAMENTS_ASYNCRESULT_HPP
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// libpq's PGresult, kept opaque so only AsyncQueryExecutor.cpp needs libpq-fe.h
+struct pg_result;
+
+/**
+ * Read side of a completed async query, shaped after the part of pqxx::field / row / result that
+ * RowMapper uses, so the same mappers decode both. Results come back in text format.
+ */
+class AsyncField {
+    const pg_result* result;
+    int row;
+    int column;
+public:
+    AsyncField(const pg_result* result, const int row, const int column) : result(result), row(row), column(column) {}
+
+    [[nodiscard]] bool is_null() const;
+    [[nodiscard]] size_t size() const;
+    // points into the result, valid while the AsyncRows it came from is alive
+    [[nodiscard]] const char* c_str() const;
+    [[nodiscard]] std::string_view view() const {
+        return {c_str(), size()};
+    }
+
+    template<typename Type>
+    [[nodiscard]] Type as() const {
+        if (is_null()) {
+            throw std::domain_error("Null value in column " + std::to_string(column));
+        }
+        const auto text = view();
+        if constexpr (std::same_as<Type, std::string>) {
+            return std::string(text);
+        } else if constexpr (std::integral<Type>) {
+            Type value{};
+            const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (error != std::errc() || end != text.data() + text.size()) {
+                throw std::domain_error("Could not convert '" + std::string(text) + "' to a number");
+            }
+            return value;
+        } else {
+            // domain::Id and the like
+            const auto value = Type::Parse(text);
+            if (!value) {
+                throw std::domain_error("Could not convert '" + std::string(text) + "'");
+            }
+            return *value;
+        }
+    }
+};
+
+class AsyncRow {
+    const pg_result* result;
+    int row;
+public:
+    AsyncRow(const pg_result* result, const int row) : result(result), row(row) {}
+
+    [[nodiscard]] size_t size() const;
+    AsyncField operator[](const int column) const {
+        return {result, row, column};
+    }
+    AsyncField operator[](const char* column) const;
+};
+
+// Rows of a completed async query, owns the PGresult
+class AsyncRows {
+    std::shared_ptr<pg_result> result;
+public:
+    AsyncRows() = default;
+    explicit AsyncRows(pg_result* result);
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    AsyncRow operator[](const size_t row) const {
+        return {result.get(), static_cast<int>(row)};
+    }
+};
+
+struct AsyncError {
+    enum class Kind {
+        // the statement failed, as a pqxx::sql_error would
+        QUERY,
+        // no connection to send it on, the async counterpart of ConnectionPoolTimeout
+        UNAVAILABLE,
+        // the request deadline passed before it was sent or cancelled it, see DeadlineExceeded
+        DEADLINE
+    };
+    Kind kind = Kind::QUERY;
+    std::string message;
+};
+
+using AsyncResult = std::expected<AsyncRows, AsyncError>;
+
+// called once, on an AsyncQueryExecutor event loop unless the answer was at hand, and must not block
+template<typename T>
+using AsyncCompletion = std::function<void(std::expected<T, AsyncError>)>;
+
+#endif //TOURNAMENTS_ASYNCRESULT_HPP
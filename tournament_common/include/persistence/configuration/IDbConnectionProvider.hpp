@@ -5,37 +5,123 @@
 #ifndef TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
 #define TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
 
+#include <chrono>
+#include <format>
 #include <memory>
-#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
 
-class IDbConnection {
+#include "PostgresConnection.hpp"
+#include "RequestDeadline.hpp"
+#include "StatementRegistry.hpp"
+
+// Raised when no pooled connection could be handed out before the acquire timeout expired
+class ConnectionPoolTimeout : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+class PooledConnection;
+
+class IDbConnectionProvider {
+    friend class PooledConnection;
+protected:
+    // give a slot handed out by Connection() back to the pool, must not allocate nor throw
+    virtual void Release(PostgresConnection* slot) noexcept = 0;
 public:
-    virtual ~IDbConnection() = default;
+    virtual ~IDbConnectionProvider() = default;
+    // false while the pool is still opening its first connections
+    [[nodiscard]] virtual bool Ready() const { return true; }
+    virtual PooledConnection Connection() = 0;
+    // connection for pqxx::read_transaction, may lag behind Connection() when served by a replica
+    virtual PooledConnection ReadConnection();
 };
 
 
 class PooledConnection {
-    std::unique_ptr<IDbConnection, std::function<void(IDbConnection*)>> connection;
+    PostgresConnection* slot = nullptr;
 public:
-    explicit PooledConnection(
-        IDbConnection* dbc,
-        std::function<void(IDbConnection*)> deleter) : connection(dbc, std::move(deleter)) {}
+    explicit PooledConnection(PostgresConnection* slot) noexcept : slot(slot) {}
+    ~PooledConnection() {
+        if (slot != nullptr) {
+            slot->owner->Release(slot);
+        }
+    }
 
-    IDbConnection* operator->() { return connection.get(); }
-    IDbConnection& operator*() { return *connection; }
+    pqxx::connection* operator->() const noexcept { return slot->connection.get(); }
+    pqxx::connection& operator*() const noexcept { return *slot->connection; }
+
+    // prepares the statement on this connection unless it already was
+    void Prepare(const PreparedStatement& statement) const {
+        auto& prepared = slot->prepared;
+        if (statement.Index() < prepared.size() && prepared[statement.Index()]) {
+            return;
+        }
+        slot->connection->prepare(statement.Name(), statement.Sql());
+        if (statement.Index() >= prepared.size()) {
+            prepared.resize(statement.Index() + 1, false);
+        }
+        prepared[statement.Index()] = true;
+    }
+
+    // caps the rest of tx at the request's remaining time when that is shorter than the session statement_timeout,
+    // so requests with time to spare do not pay the extra round trip
+    void LimitToDeadline(pqxx::transaction_base& tx) const {
+        const auto remaining = deadline::Remaining();
+        if (!remaining) {
+            return;
+        }
+        if (remaining->count() <= 0) {
+            throw DeadlineExceeded("Request deadline passed before the query was sent");
+        }
+        if (slot->statementTimeout.count() == 0 || *remaining < slot->statementTimeout) {
+            tx.exec(std::format("SET LOCAL statement_timeout = {}", remaining->count()));
+        }
+    }
        // disable copy
     PooledConnection(const PooledConnection&) = delete;
     PooledConnection& operator=(const PooledConnection&) = delete;
 
     // allow move
-    PooledConnection(PooledConnection&&) noexcept = default;
-    PooledConnection& operator=(PooledConnection&&) noexcept = default;
+    PooledConnection(PooledConnection&& other) noexcept : slot(std::exchange(other.slot, nullptr)) {}
+    PooledConnection& operator=(PooledConnection&& other) noexcept {
+        if (this != &other) {
+            if (slot != nullptr) {
+                slot->owner->Release(slot);
+            }
+            slot = std::exchange(other.slot, nullptr);
+        }
+        return *this;
+    }
 };
 
+inline PooledConnection IDbConnectionProvider::ReadConnection() {
+    return Connection();
+}
 
-class IDbConnectionProvider {
-public:
-    virtual ~IDbConnectionProvider() = default;
-    virtual PooledConnection Connection() = 0;
-};
-#endif //TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
\ No newline at end of file
+// SQLSTATE of a statement cancelled by statement_timeout
+inline constexpr std::string_view QUERY_CANCELED = "57014";
+
+// runs a registry statement in tx, preparing it on the pooled connection first and recording its latency;
+// a statement cut short by the request deadline surfaces as DeadlineExceeded
+inline pqxx::result Execute(const PooledConnection& pooled, pqxx::transaction_base& tx, PreparedStatement& statement, const pqxx::params& params = {}) {
+    pooled.Prepare(statement);
+    pooled.LimitToDeadline(tx);
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        pqxx::result result = tx.exec(pqxx::prepped{statement.Name()}, params);
+        statement.Record(std::chrono::steady_clock::now() - start, false);
+        return result;
+    } catch (const pqxx::sql_error& e) {
+        statement.Record(std::chrono::steady_clock::now() - start, true);
+        if (e.sqlstate() == QUERY_CANCELED && deadline::Remaining()) {
+            throw DeadlineExceeded(std::format("{} cancelled at the request deadline", statement.Name()));
+        }
+        throw;
+    } catch (...) {
+        statement.Record(std::chrono::steady_clock::now() - start, true);
+        throw;
+    }
+}
+#endif //TOURNAMENTS_IDBCONNECTIONPROVIDER_HPP
@@ -0,0 +1,58 @@
+#ifndef TOURNAMENTS_IDTRAITS_HPP
+#define TOURNAMENTS_IDTRAITS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <pqxx/pqxx>
+
+#include "domain/Id.hpp"
+
+/**
+ * pqxx glue for domain::Id. Fields and text parameters (uuid[] arrays, JSONB paths) go through
+ * string_traits; single ids compared with uuid columns are sent with Binary(), the 16 bytes
+ * uuid_recv takes, so the server skips parsing the text form.
+ */
+template<>
+struct pqxx::nullness<domain::Id> : pqxx::no_null<domain::Id> {};
+
+template<>
+struct pqxx::string_traits<domain::Id> {
+    static constexpr bool converts_to_string{true};
+    static constexpr bool converts_from_string{true};
+
+    static constexpr size_t size_buffer(const domain::Id&) noexcept {
+        return domain::Id::TEXT_SIZE + 1;
+    }
+
+    static char* into_buf(char* begin, char* end, const domain::Id& value) {
+        if (end - begin < static_cast<std::ptrdiff_t>(domain::Id::TEXT_SIZE + 1)) {
+            throw pqxx::conversion_overrun("Not enough buffer space to store a uuid");
+        }
+        const auto text = value.Chars();
+        char* const next = std::ranges::copy(text, begin).out;
+        *next = '\0';
+        return next + 1;
+    }
+
+    static pqxx::zview to_buf(char* begin, char* end, const domain::Id& value) {
+        char* const next = into_buf(begin, end, value);
+        return {begin, static_cast<size_t>(next - begin - 1)};
+    }
+
+    static domain::Id from_string(const std::string_view text) {
+        const auto id = domain::Id::Parse(text);
+        if (!id) {
+            throw pqxx::conversion_error("Could not convert '" + std::string(text) + "' to a uuid");
+        }
+        return *id;
+    }
+};
+
+// binary parameter for a uuid column or a $n::uuid placeholder, the view points into id
+inline pqxx::bytes_view Binary(const domain::Id& id) {
+    return {reinterpret_cast<const std::byte*>(id.Bytes().data()), id.Bytes().size()};
+}
+
+#endif //TOURNAMENTS_IDTRAITS_HPP
@@ -4,17 +4,23 @@
 
 #ifndef TOURNAMENTS_POSTGRES_CONNECTION_HPP
 #define TOURNAMENTS_POSTGRES_CONNECTION_HPP
+#include <chrono>
 #include <memory>
+#include <vector>
 #include <pqxx/pqxx>
-#include "IDbConnectionProvider.hpp"
 
+class IDbConnectionProvider;
 
-struct PostgresConnection final : IDbConnection{
+// Pool slot, allocated once by the provider and recycled together with its pqxx::connection
+struct PostgresConnection final {
     std::unique_ptr<pqxx::connection> connection;
-    explicit PostgresConnection(std::unique_ptr<pqxx::connection> connection) : connection(std::move(connection)) {
-    }
+    IDbConnectionProvider* owner = nullptr;
+    // indexed by PreparedStatement::Index(), cleared whenever the connection is reopened
+    std::vector<bool> prepared;
+    // session statement_timeout the connection was opened with, 0 when the server default applies
+    std::chrono::milliseconds statementTimeout{0};
 };
 
 
 
-#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
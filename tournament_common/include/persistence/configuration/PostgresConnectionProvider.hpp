@@ -4,79 +4,83 @@
 
 #ifndef TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
 #define TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
+#include <atomic>
 #include <condition_variable>
-#include <queue>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
 #include <pqxx/pqxx>
 
 #include "IDbConnectionProvider.hpp"
 #include "PostgresConnection.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
+#include "metrics/Metrics.hpp"
 
+/**
+ * Connection pool split in shards. Each thread has a home shard, so Crow workers
+ * mostly take and return connections without touching each other's locks; when the
+ * home shard is empty the connection is stolen from another shard, then the pool
+ * grows up to maxPoolSize and finally waits up to acquireTimeout.
+ *
+ * The minPoolSize connections are opened and get every declared statement prepared by
+ * background warmers, in parallel and without holding up construction. The pool serves
+ * requests meanwhile by growing on demand, and reports Ready() once readyPoolSize
+ * connections are warm.
+ *
+ * Acquire wait, timeouts and pool occupancy are exported under the pool label given at
+ * construction.
+ */
 class PostgresConnectionProvider : public IDbConnectionProvider{
-    std::string_view connectionString;
-    size_t poolSize = 1;
-    std::queue<std::unique_ptr<pqxx::connection>> connectionPool;
-    std::mutex connectionPoolMutex;
-    std::condition_variable connectionPoolCondition;
+    struct Shard {
+        std::mutex mutex;
+        std::vector<PostgresConnection*> idle;
+    };
 
-public:
-    PostgresConnectionProvider(std::string_view connectionString, size_t poolSize) : connectionString(connectionString), poolSize(poolSize) {
-        for (size_t i = 0; i < poolSize; i++) {
-            connectionPool.push(std::make_unique<pqxx::connection>(connectionString.data()));
-            connectionPool.back()->prepare("insert_tournament", "insert into TOURNAMENTS (document) values($1) RETURNING id");
-            connectionPool.back()->prepare("select_tournament_by_id", "select * from TOURNAMENTS where id = $1");
-
-            connectionPool.back()->prepare("insert_team", "insert into TEAMS (document) values($1) RETURNING id");
-            connectionPool.back()->prepare("select_team_by_id", "select * from TEAMS where id = $1");
-
-            connectionPool.back()->prepare("insert_group", "insert into GROUPS (tournament_id, document) values($1, $2) RETURNING id");
-            connectionPool.back()->prepare("select_groups_by_tournament", "select * from GROUPS where tournament_id = $1");
-            connectionPool.back()->prepare("select_group_in_tournament", R"(
-                select * from groups
-                where  tournament_id = $1
-                and document @> jsonb_build_object('teams', jsonb_build_array(jsonb_build_object('id', $2::text)))
-            )");
+    config::DatabaseConfiguration configuration;
+    // one slot per possible connection, allocated up front so handing out and releasing never allocates
+    std::vector<std::unique_ptr<PostgresConnection>> slots;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t> openConnections{0};
+    std::mutex spareMutex;
+    std::vector<PostgresConnection*> spare;
 
-            connectionPool.back()->prepare("select_group_by_tournamentid_groupid", "select * from GROUPS where tournament_id = $1 and id = $2");
-            // connectionPool.back()->prepare("update_group", "update GROUPS set name = $2, last_update_date = CURRENT_TIMESTAMP where id = $1  RETURNING id");
-            connectionPool.back()->prepare("update_group_add_team", R"(
-                update groups
-                    set document = jsonb_insert(
-                            document, '{teams,-1}', $2
-                                   ),
-                    last_update_date = CURRENT_TIMESTAMP
-                where id = $1
-            )");
-        }
-    }
+    std::mutex waitMutex;
+    std::condition_variable connectionAvailable;
+    std::atomic<size_t> waiters{0};
 
-    PooledConnection Connection() override {
-        std::unique_lock lock(connectionPoolMutex);
+    metrics::Histogram& acquireLatency;
+    metrics::Counter& acquireTimeouts;
+    // removed before the shards they read go away
+    std::vector<metrics::Sampler> samplers;
 
-        // wait until a connection is available
-        connectionPoolCondition.wait(lock, [this] { return !connectionPool.empty(); });
+    size_t readyConnections;
+    std::atomic<size_t> warmedConnections{0};
+    // opened on demand by requests, they count toward readiness too since warmers cannot open them again
+    std::atomic<size_t> requestOpenedConnections{0};
+    std::atomic<size_t> nextWarmup{0};
+    std::mutex warmupMutex;
+    std::condition_variable_any warmupRetry;
+    // declared last so the warmers are stopped and joined before anything they touch is destroyed
+    std::vector<std::jthread> warmers;
 
-        // take one out
-        auto conn = std::move(connectionPool.front());
-        connectionPool.pop();
+    [[nodiscard]] size_t HomeShard() const;
+    PostgresConnection* TryTake(size_t homeShard, bool blocking = false);
+    PostgresConnection* TryGrow();
+    PostgresConnection* TryGrowForRequest();
+    std::unique_ptr<pqxx::connection> Open() const;
+    void WarmUp(const std::stop_token& stop);
+    [[nodiscard]] size_t IdleConnections();
+    void RegisterSamplers(const std::string& poolName);
 
-        // build PostgresConnection wrapper (adapts pqxx::connection -> IDbConnection)
-        auto dbc = new PostgresConnection(std::move(conn));
+protected:
+    void Release(PostgresConnection* slot) noexcept override;
 
-        // return a RAII PooledConnection
-        return PooledConnection(
-            dbc,
-            [this](IDbConnection* dbc) {
-                auto pc = dynamic_cast<PostgresConnection*>(dbc);
-
-                {
-                    std::lock_guard<std::mutex> lock(connectionPoolMutex);
-                    connectionPool.push(std::move(pc->connection));
-                }
+public:
+    explicit PostgresConnectionProvider(const config::DatabaseConfiguration& configuration, const std::string& poolName = "primary");
 
-                delete pc;
-                connectionPoolCondition.notify_one();
-            }
-        );
-    }
+    [[nodiscard]] bool Ready() const override;
+    PooledConnection Connection() override;
 };
-#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_POSTGRESCONNECTIONPROVIDER_HPP
@@ -0,0 +1,41 @@
+#ifndef TOURNAMENTS_READWRITECONNECTIONPROVIDER_HPP
+#define TOURNAMENTS_READWRITECONNECTIONPROVIDER_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "IDbConnectionProvider.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
+
+/**
+ * Routes writes to the primary pool and reads to a separate read pool. When the read pool
+ * points at a streaming replica its replay lag is sampled every lagCheckInterval, piggybacked
+ * on ReadConnection(), and reads fall back to the primary while the lag is above maxReplicaLag
+ * or the replica cannot be reached.
+ */
+class ReadWriteConnectionProvider : public IDbConnectionProvider {
+    std::shared_ptr<IDbConnectionProvider> writePool;
+    std::shared_ptr<IDbConnectionProvider> readPool;
+    config::ReadPoolConfiguration configuration;
+    bool replica;
+    std::atomic<bool> replicaUsable{true};
+    std::atomic<int64_t> nextLagCheck{0};
+
+    bool ReplicaWithinLag();
+
+protected:
+    // slots are handed out and taken back by the underlying pools
+    void Release(PostgresConnection*) noexcept override {}
+
+public:
+    explicit ReadWriteConnectionProvider(const config::DatabaseConfiguration& configuration);
+
+    // the plain pool when no read pool is configured
+    static std::shared_ptr<IDbConnectionProvider> Create(const config::DatabaseConfiguration& configuration);
+
+    [[nodiscard]] bool Ready() const override;
+    PooledConnection Connection() override;
+    PooledConnection ReadConnection() override;
+};
+
+#endif //TOURNAMENTS_READWRITECONNECTIONPROVIDER_HPP
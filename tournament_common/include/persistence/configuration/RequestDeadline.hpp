@@ -0,0 +1,46 @@
+#ifndef TOURNAMENTS_REQUESTDEADLINE_HPP
+#define TOURNAMENTS_REQUESTDEADLINE_HPP
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+
+// Raised when the request ran out of time while waiting for a connection or a query
+class DeadlineExceeded : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Deadline of the request the current thread is serving. Blocking handlers run to completion on
+ * one worker thread, so the admission middleware sets it before the handler and clears it after,
+ * and the connection pool and Execute read it without it being threaded through every call.
+ * Queries on the AsyncQueryExecutor outlive the thread, they carry the deadline in AsyncQuery.
+ */
+namespace deadline {
+    using Clock = std::chrono::steady_clock;
+
+    inline Clock::time_point& Current() {
+        thread_local Clock::time_point current = Clock::time_point::max();
+        return current;
+    }
+
+    inline void Set(const Clock::time_point point) {
+        Current() = point;
+    }
+
+    inline void Clear() {
+        Current() = Clock::time_point::max();
+    }
+
+    // time left, nullopt when the thread is not serving a request with a deadline
+    inline std::optional<std::chrono::milliseconds> Remaining() {
+        const auto point = Current();
+        if (point == Clock::time_point::max()) {
+            return std::nullopt;
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(point - Clock::now());
+    }
+}
+
+#endif //TOURNAMENTS_REQUESTDEADLINE_HPP
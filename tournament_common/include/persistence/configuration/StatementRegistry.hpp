@@ -0,0 +1,82 @@
+#ifndef TOURNAMENTS_STATEMENTREGISTRY_HPP
+#define TOURNAMENTS_STATEMENTREGISTRY_HPP
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "metrics/Metrics.hpp"
+
+class PreparedStatement {
+    std::string name;
+    std::string sql;
+    size_t index;
+    metrics::Histogram& latency;
+    metrics::Counter& errors;
+public:
+    PreparedStatement(std::string name, std::string sql, const size_t index)
+        : name(std::move(name)), sql(std::move(sql)), index(index),
+          latency(metrics::Registry::Instance().GetHistogram("db_statement_duration_seconds",
+              "Time prepared statements took to run, errors included", {{"statement", this->name}})),
+          errors(metrics::Registry::Instance().GetCounter("db_statement_errors_total",
+              "Prepared statement runs that raised an error", {{"statement", this->name}})) {}
+
+    [[nodiscard]] const std::string& Name() const { return name; }
+    [[nodiscard]] const std::string& Sql() const { return sql; }
+    // position in the registry, used by connections to remember what they already prepared
+    [[nodiscard]] size_t Index() const { return index; }
+    [[nodiscard]] const metrics::Histogram& Latency() const { return latency; }
+    [[nodiscard]] const metrics::Counter& Errors() const { return errors; }
+
+    void Record(const std::chrono::steady_clock::duration elapsed, const bool failed) {
+        latency.Observe(elapsed);
+        if (failed) {
+            errors.Increment();
+        }
+    }
+};
+
+/**
+ * Process wide catalog of prepared statements. Repositories declare the statements they use
+ * as namespace scope constants; pooled connections prepare a statement the first time it runs
+ * on them and forget them all when the connection is reopened.
+ */
+class StatementRegistry {
+    mutable std::mutex mutex;
+    // deque keeps the references handed out by Declare valid
+    std::deque<std::unique_ptr<PreparedStatement>> statements;
+
+    StatementRegistry() = default;
+public:
+    static StatementRegistry& Instance() {
+        static StatementRegistry registry;
+        return registry;
+    }
+
+    PreparedStatement& Declare(std::string name, std::string sql) {
+        std::lock_guard lock(mutex);
+        for (const auto& statement : statements) {
+            if (statement->Name() == name) {
+                if (statement->Sql() != sql) {
+                    throw std::logic_error("Statement " + name + " declared twice with different SQL");
+                }
+                return *statement;
+            }
+        }
+        statements.push_back(std::make_unique<PreparedStatement>(std::move(name), std::move(sql), statements.size()));
+        return *statements.back();
+    }
+
+    template<typename Visitor>
+    void ForEach(Visitor&& visitor) const {
+        std::lock_guard lock(mutex);
+        for (const auto& statement : statements) {
+            visitor(*statement);
+        }
+    }
+};
+
+#endif //TOURNAMENTS_STATEMENTREGISTRY_HPP
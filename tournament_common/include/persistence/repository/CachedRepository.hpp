@@ -0,0 +1,112 @@
+#ifndef COMMON_CACHED_REPOSITORY_HPP
+#define COMMON_CACHED_REPOSITORY_HPP
+
+#include <memory>
+#include <string>
+
+#include "IRepository.hpp"
+#include "IAsyncRepository.hpp"
+#include "cache/EntityCache.hpp"
+#include "cms/CacheInvalidationBus.hpp"
+#include "configuration/CacheConfiguration.hpp"
+
+/**
+ * Read-through caching decorator for any IRepository. Only ReadById is cached; writes going through
+ * the decorator evict the entry locally and on every other instance through the invalidation bus.
+ * ReadByIdAsync shares the cache, a hit completes on the calling thread.
+ */
+template<typename Type, typename Id>
+class CachedRepository : public IRepository<Type, Id>, public IAsyncRepository<Type, Id> {
+    std::shared_ptr<IRepository<Type, Id>> repository;
+    std::shared_ptr<IAsyncRepository<Type, Id>> asyncRepository;
+    std::shared_ptr<CacheInvalidationBus> invalidationBus;
+    std::string cacheName;
+    EntityCache<Type, Id> cache;
+
+    // only the invalidation messages carry the text form of the id
+    void Evict(const Id& id) {
+        cache.Invalidate(id);
+        if (invalidationBus) {
+            invalidationBus->Publish(cacheName, id.ToString());
+        }
+    }
+
+public:
+    CachedRepository(std::shared_ptr<IRepository<Type, Id>> repository,
+                     std::shared_ptr<IAsyncRepository<Type, Id>> asyncRepository,
+                     std::shared_ptr<CacheInvalidationBus> invalidationBus,
+                     const std::string_view& cacheName,
+                     const config::CacheConfiguration& configuration)
+        : repository(std::move(repository)), asyncRepository(std::move(asyncRepository)), invalidationBus(std::move(invalidationBus)), cacheName(cacheName),
+          cache(configuration.capacity, configuration.ttl) {
+        if (this->invalidationBus) {
+            this->invalidationBus->Subscribe(this->cacheName, [this](const std::string& key) {
+                if (const auto id = Id::Parse(key)) {
+                    cache.Invalidate(*id);
+                }
+            });
+        }
+    }
+
+    std::shared_ptr<Type> ReadById(Id id) override {
+        if (const auto cached = cache.Find(id)) {
+            // callers get their own copy, the cached instance is shared between threads
+            return std::make_shared<Type>(*cached);
+        }
+        auto entity = repository->ReadById(id);
+        if (entity != nullptr) {
+            cache.Put(id, std::make_shared<const Type>(*entity));
+        }
+        return entity;
+    }
+
+    void ReadByIdAsync(const Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<Type>> completion) override {
+        if (const auto cached = cache.Find(id)) {
+            completion(std::make_shared<Type>(*cached));
+            return;
+        }
+        asyncRepository->ReadByIdAsync(id, deadline, [this, id, completion = std::move(completion)](std::expected<std::shared_ptr<Type>, AsyncError> entity) {
+            if (entity && *entity != nullptr) {
+                cache.Put(id, std::make_shared<const Type>(**entity));
+            }
+            completion(std::move(entity));
+        });
+    }
+
+    Id Create(const Type& entity) override {
+        return repository->Create(entity);
+    }
+
+    Id Update(const Type& entity) override {
+        Id id = repository->Update(entity);
+        Evict(id);
+        return id;
+    }
+
+    void Delete(Id id) override {
+        repository->Delete(id);
+        Evict(id);
+    }
+
+    std::vector<std::shared_ptr<Type>> ReadAll() override {
+        return repository->ReadAll();
+    }
+
+    Page<Type> ReadPage(const PageRequest& request) override {
+        return repository->ReadPage(request);
+    }
+
+    void ReadPageAsync(const PageRequest& request, const deadline::Clock::time_point deadline, AsyncCompletion<Page<Type>> completion) override {
+        asyncRepository->ReadPageAsync(request, deadline, std::move(completion));
+    }
+
+    [[nodiscard]] const CacheStats& Stats() const {
+        return cache.Stats();
+    }
+
+    [[nodiscard]] size_t Size() {
+        return cache.Size();
+    }
+};
+
+#endif //COMMON_CACHED_REPOSITORY_HPP
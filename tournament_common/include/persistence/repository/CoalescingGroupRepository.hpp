@@ -0,0 +1,100 @@
+#ifndef COMMON_COALESCING_GROUP_REPOSITORY_HPP
+#define COMMON_COALESCING_GROUP_REPOSITORY_HPP
+
+#include <memory>
+
+#include "IGroupRepository.hpp"
+#include "IBatchRepository.hpp"
+#include "RequestCoalescer.hpp"
+#include "configuration/CoalescingConfiguration.hpp"
+
+/**
+ * IGroupRepository decorator coalescing FindByTournamentIdAndGroupId. Reads are batched by group
+ * id alone, group ids are unique across tournaments, and a group found under another tournament
+ * is answered as missing just like the single query would. Everything else is forwarded; writes
+ * to a group make later readers start a new query.
+ */
+class CoalescingGroupRepository : public IGroupRepository {
+    std::shared_ptr<IGroupRepository> repository;
+    RequestCoalescer<domain::Group> coalescer;
+
+public:
+    CoalescingGroupRepository(std::shared_ptr<IGroupRepository> repository,
+                              std::shared_ptr<IBatchRepository<domain::Group>> batchRepository,
+                              const config::CoalescingConfiguration& configuration)
+        : repository(std::move(repository)),
+          coalescer([batchRepository = std::move(batchRepository)](const std::vector<domain::Id>& ids) {
+              return batchRepository->ReadByIds(ids);
+          }, configuration) {}
+
+    std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const domain::Id& tournamentId, const domain::Id& groupId) override {
+        auto group = coalescer.Load(groupId);
+        if (group == nullptr || group->TournamentId() != tournamentId) {
+            return nullptr;
+        }
+        return group;
+    }
+
+    std::shared_ptr<domain::Group> ReadById(domain::Id id) override {
+        return repository->ReadById(id);
+    }
+
+    domain::Id Create(const domain::Group& entity) override {
+        return repository->Create(entity);
+    }
+
+    domain::Id Update(const domain::Group& entity) override {
+        domain::Id id = repository->Update(entity);
+        coalescer.Forget(id);
+        return id;
+    }
+
+    void Delete(domain::Id id) override {
+        repository->Delete(id);
+        coalescer.Forget(id);
+    }
+
+    std::vector<std::shared_ptr<domain::Group>> ReadAll() override {
+        return repository->ReadAll();
+    }
+
+    Page<domain::Group> ReadPage(const PageRequest& request) override {
+        return repository->ReadPage(request);
+    }
+
+    std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const domain::Id& tournamentId) override {
+        return repository->FindByTournamentId(tournamentId);
+    }
+
+    std::optional<ResourceVersion> FindVersion(const domain::Id& tournamentId, const domain::Id& groupId) override {
+        return repository->FindVersion(tournamentId, groupId);
+    }
+
+    std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const domain::Id& tournamentId, const domain::Id& teamId) override {
+        return repository->FindByTournamentIdAndTeamId(tournamentId, teamId);
+    }
+
+    GroupTeamsUpdate AddTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Id>& teamIds, std::string_view eventQueue) override {
+        auto update = repository->AddTeams(tournamentId, groupId, teamIds, eventQueue);
+        coalescer.Forget(groupId);
+        return update;
+    }
+
+    bool IsTeamInTournament(const domain::Id& tournamentId, const domain::Id& teamId) override {
+        return repository->IsTeamInTournament(tournamentId, teamId);
+    }
+
+    std::optional<domain::Id> FindGroupIdByTeamId(const domain::Id& tournamentId, const domain::Id& teamId) override {
+        return repository->FindGroupIdByTeamId(tournamentId, teamId);
+    }
+
+    size_t CountTeamsInGroup(const domain::Id& groupId) override {
+        return repository->CountTeamsInGroup(groupId);
+    }
+
+    [[nodiscard]] const CoalescingStats& Stats() const {
+        return coalescer.Stats();
+    }
+};
+
+#endif //COMMON_COALESCING_GROUP_REPOSITORY_HPP
@@ -0,0 +1,63 @@
+#ifndef COMMON_COALESCING_REPOSITORY_HPP
+#define COMMON_COALESCING_REPOSITORY_HPP
+
+#include <memory>
+
+#include "IRepository.hpp"
+#include "IBatchRepository.hpp"
+#include "RequestCoalescer.hpp"
+#include "configuration/CoalescingConfiguration.hpp"
+#include "domain/Id.hpp"
+
+/**
+ * Decorator for any IRepository that has a batch read: ReadById goes through a RequestCoalescer,
+ * so concurrent reads share pooled connections instead of each taking one. Meant to sit below
+ * CachedRepository, where only cache misses reach it.
+ */
+template<typename Type>
+class CoalescingRepository : public IRepository<Type, domain::Id> {
+    std::shared_ptr<IRepository<Type, domain::Id>> repository;
+    RequestCoalescer<Type> coalescer;
+
+public:
+    CoalescingRepository(std::shared_ptr<IRepository<Type, domain::Id>> repository,
+                         std::shared_ptr<IBatchRepository<Type>> batchRepository,
+                         const config::CoalescingConfiguration& configuration)
+        : repository(std::move(repository)),
+          coalescer([batchRepository = std::move(batchRepository)](const std::vector<domain::Id>& ids) {
+              return batchRepository->ReadByIds(ids);
+          }, configuration) {}
+
+    std::shared_ptr<Type> ReadById(domain::Id id) override {
+        return coalescer.Load(id);
+    }
+
+    domain::Id Create(const Type& entity) override {
+        return repository->Create(entity);
+    }
+
+    domain::Id Update(const Type& entity) override {
+        domain::Id id = repository->Update(entity);
+        coalescer.Forget(id);
+        return id;
+    }
+
+    void Delete(domain::Id id) override {
+        repository->Delete(id);
+        coalescer.Forget(id);
+    }
+
+    std::vector<std::shared_ptr<Type>> ReadAll() override {
+        return repository->ReadAll();
+    }
+
+    Page<Type> ReadPage(const PageRequest& request) override {
+        return repository->ReadPage(request);
+    }
+
+    [[nodiscard]] const CoalescingStats& Stats() const {
+        return coalescer.Stats();
+    }
+};
+
+#endif //COMMON_COALESCING_REPOSITORY_HPP
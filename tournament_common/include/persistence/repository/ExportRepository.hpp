@@ -0,0 +1,20 @@
+#ifndef COMMON_EXPORTREPOSITORY_HPP
+#define COMMON_EXPORTREPOSITORY_HPP
+
+#include <memory>
+
+#include "IExportRepository.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+
+/**
+ * Streams documents out of Postgres with COPY (pqxx stream_from) and writes each row as one NDJSON
+ * line. The JSON text is produced by Postgres, so no domain object or JSON DOM is built per row.
+ */
+class ExportRepository : public IExportRepository {
+    std::shared_ptr<IDbConnectionProvider> connectionProvider;
+public:
+    explicit ExportRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider);
+    std::optional<KeysetPosition> ExportNdjson(ExportSource source, const PageRequest& request, std::string& output) override;
+};
+
+#endif //COMMON_EXPORTREPOSITORY_HPP
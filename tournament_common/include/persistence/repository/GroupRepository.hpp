@@ -9,23 +9,40 @@
 #include <memory>
 
 #include "IGroupRepository.hpp"
+#include "IAsyncGroupRepository.hpp"
+#include "IBatchRepository.hpp"
+#include "persistence/configuration/AsyncQueryExecutor.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
 #include "domain/Group.hpp"
 
-class GroupRepository : public IGroupRepository {
+class GroupRepository : public IGroupRepository, public IBatchRepository<domain::Group>, public IAsyncGroupRepository {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    std::shared_ptr<AsyncQueryExecutor> asyncExecutor;
 public:
-    explicit GroupRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider);
-    std::shared_ptr<domain::Group> ReadById(std::string id) override;
-    std::string Create (const domain::Group & entity) override;
-    std::string Update (const domain::Group & entity) override;
-    void Delete(std::string id) override;
+    // without an executor the async reads complete as unavailable
+    GroupRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider, std::shared_ptr<AsyncQueryExecutor> asyncExecutor);
+    std::shared_ptr<domain::Group> ReadById(domain::Id id) override;
+    domain::Id Create (const domain::Group & entity) override;
+    domain::Id Update (const domain::Group & entity) override;
+    void Delete(domain::Id id) override;
     std::vector<std::shared_ptr<domain::Group>> ReadAll() override;
-    std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const std::string_view& tournamentId) override;
-    std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) override;
-    std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) override;
-    void UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) override;
+    Page<domain::Group> ReadPage(const PageRequest& request) override;
+    std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const domain::Id& tournamentId) override;
+    void FindByTournamentIdAsync(const domain::Id& tournamentId, deadline::Clock::time_point deadline,
+                                 AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion) override;
+    std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const domain::Id& tournamentId, const domain::Id& groupId) override;
+    void FindByTournamentIdAndGroupIdAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                                           AsyncCompletion<std::shared_ptr<domain::Group>> completion) override;
+    std::vector<std::shared_ptr<domain::Group>> ReadByIds(const std::vector<domain::Id>& ids) override;
+    std::optional<ResourceVersion> FindVersion(const domain::Id& tournamentId, const domain::Id& groupId) override;
+    void FindVersionAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                          AsyncCompletion<std::optional<ResourceVersion>> completion) override;
+    std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const domain::Id& tournamentId, const domain::Id& teamId) override;
+    GroupTeamsUpdate AddTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Id>& teamIds, std::string_view eventQueue) override;
+    bool IsTeamInTournament(const domain::Id& tournamentId, const domain::Id& teamId) override;
+    std::optional<domain::Id> FindGroupIdByTeamId(const domain::Id& tournamentId, const domain::Id& teamId) override;
+    size_t CountTeamsInGroup(const domain::Id& groupId) override;
 };
 
 #endif //TOURNAMENTS_GROUPREPOSITORY_HPP
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef COMMON_IASYNCGROUPREPOSITORY_HPP
+#define COMMON_IASYNCGROUPREPOSITORY_HPP
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "IVersionRepository.hpp"
+#include "domain/Group.hpp"
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+
+// IGroupRepository reads of the async GET routes, same results as their blocking counterparts
+class IAsyncGroupRepository {
+public:
+    virtual ~IAsyncGroupRepository() = default;
+    virtual void FindByTournamentIdAsync(const domain::Id& tournamentId, deadline::Clock::time_point deadline,
+                                         AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion) = 0;
+    virtual void FindByTournamentIdAndGroupIdAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                                                   AsyncCompletion<std::shared_ptr<domain::Group>> completion) = 0;
+    virtual void FindVersionAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                                  AsyncCompletion<std::optional<ResourceVersion>> completion) = 0;
+};
+
+#endif //COMMON_IASYNCGROUPREPOSITORY_HPP
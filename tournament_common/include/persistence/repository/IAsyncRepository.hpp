@@ -0,0 +1,20 @@
+#ifndef COMMON_IASYNCREPOSITORY_HPP
+#define COMMON_IASYNCREPOSITORY_HPP
+
+#include <memory>
+
+#include "Page.hpp"
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+
+// Reads of the hot GET routes that do not hold the calling thread, completed from an AsyncQueryExecutor
+// loop. A missing entity completes with nullptr; the deadline is the request's.
+template<typename Type, typename Id>
+class IAsyncRepository {
+public:
+    virtual ~IAsyncRepository() = default;
+    virtual void ReadByIdAsync(const Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<Type>> completion) = 0;
+    virtual void ReadPageAsync(const PageRequest& request, deadline::Clock::time_point deadline, AsyncCompletion<Page<Type>> completion) = 0;
+};
+
+#endif //COMMON_IASYNCREPOSITORY_HPP
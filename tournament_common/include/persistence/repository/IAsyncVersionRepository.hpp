@@ -0,0 +1,20 @@
+#ifndef COMMON_IASYNCVERSIONREPOSITORY_HPP
+#define COMMON_IASYNCVERSIONREPOSITORY_HPP
+
+#include <optional>
+
+#include "IVersionRepository.hpp"
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+
+// IVersionRepository lookups for the async GET routes
+template<typename Type>
+class IAsyncVersionRepository {
+public:
+    virtual ~IAsyncVersionRepository() = default;
+    // nullopt when the row does not exist
+    virtual void ReadVersionAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) = 0;
+    virtual void ReadCollectionVersionAsync(deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) = 0;
+};
+
+#endif //COMMON_IASYNCVERSIONREPOSITORY_HPP
@@ -0,0 +1,17 @@
+#ifndef COMMON_IBATCHREPOSITORY_HPP
+#define COMMON_IBATCHREPOSITORY_HPP
+
+#include <memory>
+#include <vector>
+
+#include "domain/Id.hpp"
+
+template<typename Type>
+class IBatchRepository {
+public:
+    virtual ~IBatchRepository() = default;
+    // one query for all ids, ids without an entity are left out and the order is not specified
+    virtual std::vector<std::shared_ptr<Type>> ReadByIds(const std::vector<domain::Id>& ids) = 0;
+};
+
+#endif //COMMON_IBATCHREPOSITORY_HPP
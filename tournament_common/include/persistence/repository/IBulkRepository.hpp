@@ -0,0 +1,17 @@
+#ifndef COMMON_IBULKREPOSITORY_HPP
+#define COMMON_IBULKREPOSITORY_HPP
+
+#include <optional>
+#include <vector>
+
+#include "domain/Id.hpp"
+
+template<typename Type>
+class IBulkRepository {
+public:
+    virtual ~IBulkRepository() = default;
+    // one entry per input entity in input order, nullopt when the entity conflicted with an existing one
+    virtual std::vector<std::optional<domain::Id>> CreateAll(const std::vector<Type>& entities) = 0;
+};
+
+#endif //COMMON_IBULKREPOSITORY_HPP
@@ -0,0 +1,18 @@
+#ifndef COMMON_IEXPORTREPOSITORY_HPP
+#define COMMON_IEXPORTREPOSITORY_HPP
+
+#include <optional>
+#include <string>
+
+#include "Page.hpp"
+
+enum class ExportSource { TEAMS, TOURNAMENTS, GROUPS };
+
+class IExportRepository {
+public:
+    virtual ~IExportRepository() = default;
+    // appends up to request.limit documents as NDJSON to output, returns where the next batch starts
+    virtual std::optional<KeysetPosition> ExportNdjson(ExportSource source, const PageRequest& request, std::string& output) = 0;
+};
+
+#endif //COMMON_IEXPORTREPOSITORY_HPP
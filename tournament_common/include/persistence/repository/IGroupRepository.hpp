@@ -5,15 +5,39 @@
 #ifndef COMMON_IGROUPREPOSITORY_HPP
 #define COMMON_IGROUPREPOSITORY_HPP
 
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+
 #include "domain/Group.hpp"
+#include "domain/Team.hpp"
 #include "IRepository.hpp"
+#include "IVersionRepository.hpp"
+
+enum class GroupTeamsStatus { APPENDED, GROUP_NOT_FOUND, GROUP_FULL, DUPLICATED, MISSING_TEAM };
 
+// Outcome of appending a batch of teams to a group, nothing is written unless the status is APPENDED
+struct GroupTeamsUpdate {
+    GroupTeamsStatus status = GroupTeamsStatus::GROUP_NOT_FOUND;
+    std::vector<domain::Id> duplicatedTeamIds;
+    std::vector<domain::Id> missingTeamIds;
+    std::vector<std::shared_ptr<domain::Team>> addedTeams;
+};
 
-class IGroupRepository : public IRepository<domain::Group, std::string> {
+class IGroupRepository : public IRepository<domain::Group, domain::Id> {
 public:
-    virtual std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const std::string_view& tournamentId) = 0;
-    virtual std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
-    virtual std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) = 0;
-    virtual void UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) = 0;
+    virtual std::vector<std::shared_ptr<domain::Group>> FindByTournamentId(const domain::Id& tournamentId) = 0;
+    virtual std::shared_ptr<domain::Group> FindByTournamentIdAndGroupId(const domain::Id& tournamentId, const domain::Id& groupId) = 0;
+    // last_update_date of the group, nullopt when it is not in the tournament
+    virtual std::optional<ResourceVersion> FindVersion(const domain::Id& tournamentId, const domain::Id& groupId) = 0;
+    virtual std::shared_ptr<domain::Group> FindByTournamentIdAndTeamId(const domain::Id& tournamentId, const domain::Id& teamId) = 0;
+    // checks the group, its capacity against the tournament's max teams per group, membership and team
+    // existence and appends all teams in a single statement, queueing one outbox message per added team on eventQueue
+    virtual GroupTeamsUpdate AddTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Id>& teamIds, std::string_view eventQueue) = 0;
+    // membership lookups answered from group_teams, the group document is not read
+    virtual bool IsTeamInTournament(const domain::Id& tournamentId, const domain::Id& teamId) = 0;
+    virtual std::optional<domain::Id> FindGroupIdByTeamId(const domain::Id& tournamentId, const domain::Id& teamId) = 0;
+    virtual size_t CountTeamsInGroup(const domain::Id& groupId) = 0;
 };
-#endif //COMMON_IGROUPREPOSITORY_HPP
\ No newline at end of file
+#endif //COMMON_IGROUPREPOSITORY_HPP
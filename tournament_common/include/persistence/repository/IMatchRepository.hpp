@@ -5,17 +5,18 @@
 #ifndef TOURNAMENTS_IMATCHREPOSITORY_HPP
 #define TOURNAMENTS_IMATCHREPOSITORY_HPP
 
-#include <string_view>
 #include <vector>
 #include <memory>
 
+#include "IRepository.hpp"
+#include "IBulkRepository.hpp"
 #include "domain/Match.hpp"
 
-class IMatchRepository : public IRepository<domain::Match, std::string> {
+class IMatchRepository : public IRepository<domain::Match, domain::Id>, public IBulkRepository<domain::Match> {
 public:
     virtual ~IMatchRepository() = default;
     //Find match with only one team to be added
-    virtual std::shared_ptr<domain::Match> FindLastOpenMatch(const std::string_view& tournamentId) = 0;
-    virtual std::vector<domain::Match> FindMatchesByTournamentAndRound(const std::string_view& tournamentId) = 0;
+    virtual std::shared_ptr<domain::Match> FindLastOpenMatch(const domain::Id& tournamentId) = 0;
+    virtual std::vector<domain::Match> FindMatchesByTournamentAndRound(const domain::Id& tournamentId, int round) = 0;
 };
 #endif //TOURNAMENTS_IMATCHREPOSITORY_HPP
\ No newline at end of file
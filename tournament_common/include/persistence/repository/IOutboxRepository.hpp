@@ -0,0 +1,17 @@
+#ifndef COMMON_IOUTBOXREPOSITORY_HPP
+#define COMMON_IOUTBOXREPOSITORY_HPP
+
+#include <string_view>
+
+#include "domain/Id.hpp"
+
+// writes that announce themselves through the OUTBOX table, drained to the broker by OutboxRelay
+template<typename Type>
+class IOutboxRepository {
+public:
+    virtual ~IOutboxRepository() = default;
+    // creates the entity and queues its id on queue in the same transaction
+    virtual domain::Id CreateWithEvent(const Type& entity, std::string_view queue) = 0;
+};
+
+#endif //COMMON_IOUTBOXREPOSITORY_HPP
@@ -7,6 +7,8 @@
 #include <vector>
 #include <memory>
 
+#include "Page.hpp"
+
 template<typename Type, typename Id>
 class IRepository {
 public:
@@ -16,5 +18,7 @@ public:
     virtual Id Update (const Type & entity) = 0;
     virtual void Delete(Id id) = 0;
     virtual std::vector<std::shared_ptr<Type>> ReadAll() = 0;
+    // keyset page in (created_at, id) order, bounded by request.limit
+    virtual Page<Type> ReadPage(const PageRequest& request) = 0;
 };
 #endif //RESTAPI_IREPOSITORY_HPP
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef COMMON_IVERSIONREPOSITORY_HPP
+#define COMMON_IVERSIONREPOSITORY_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "domain/Id.hpp"
+
+// What a conditional GET is validated against: last_update_date of the row, or for a whole table the
+// COLLECTION_VERSIONS row its triggers keep, whose revision changes on deletes too
+struct ResourceVersion {
+    std::chrono::sys_time<std::chrono::microseconds> lastModified{};
+    int64_t count = 1;
+};
+
+// version lookups that read last_update_date only, never the document
+template<typename Type>
+class IVersionRepository {
+public:
+    virtual ~IVersionRepository() = default;
+    // nullopt when the row does not exist
+    virtual std::optional<ResourceVersion> ReadVersion(const domain::Id& id) = 0;
+    virtual ResourceVersion ReadCollectionVersion() = 0;
+};
+
+#endif //COMMON_IVERSIONREPOSITORY_HPP
@@ -4,41 +4,179 @@
 
 #ifndef TOURNAMENTS_MATCHREPOSITORY_HPP
 #define TOURNAMENTS_MATCHREPOSITORY_HPP
+#include <format>
+#include <nlohmann/json.hpp>
+
 #include "IMatchRepository.hpp"
+#include "RowMapper.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
+#include "persistence/configuration/IdTraits.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
+#include "domain/JsonSerializer.hpp"
 
 
 class MatchRepository: public IMatchRepository {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
+
+    static inline PreparedStatement& INSERT_MATCH = StatementRegistry::Instance().Declare(
+        "insert_match", "insert into MATCHES (tournament_id, round, document) values($1, $2, $3) RETURNING id");
+    // ids are generated up front so they come back in input order, the schedule is written in one statement
+    static inline PreparedStatement& INSERT_MATCHES = StatementRegistry::Instance().Declare("insert_matches", R"(
+        with input as (
+            select uuid_generate_v4() as id, m.tournament_id, m.round, m.document, m.position
+            from unnest($1::uuid[], $2::int[], $3::jsonb[]) with ordinality m(tournament_id, round, document, position)
+        ), inserted as (
+            insert into MATCHES (id, tournament_id, round, document)
+            select id, tournament_id, round, document from input
+        )
+        select id from input order by position
+    )");
+    static inline PreparedStatement& UPDATE_MATCH = StatementRegistry::Instance().Declare(
+        "update_match", "update MATCHES set document = $2, last_update_date = CURRENT_TIMESTAMP where id = $1 RETURNING id");
+    static inline PreparedStatement& DELETE_MATCH = StatementRegistry::Instance().Declare(
+        "delete_match", "delete from MATCHES where id = $1");
+    static inline PreparedStatement& SELECT_MATCH_BY_ID = StatementRegistry::Instance().Declare(
+        "select_match_by_id", std::format("select {} from MATCHES where id = $1", RowMapper<domain::Match>::COLUMNS));
+    static inline PreparedStatement& SELECT_MATCHES_PAGE = StatementRegistry::Instance().Declare("select_matches_page",
+        std::format("select {}, created_at::text as created_at from MATCHES order by created_at, id limit $1", RowMapper<domain::Match>::COLUMNS));
+    static inline PreparedStatement& SELECT_MATCHES_PAGE_AFTER = StatementRegistry::Instance().Declare("select_matches_page_after", std::format(R"(
+        select {}, created_at::text as created_at from MATCHES
+        where (created_at, id) > ($1::timestamp, $2::uuid)
+        order by created_at, id limit $3
+    )", RowMapper<domain::Match>::COLUMNS));
+    // served by match_tournament_round_idx
+    static inline PreparedStatement& SELECT_MATCHES_BY_TOURNAMENT_ROUND = StatementRegistry::Instance().Declare("select_matches_by_tournament_round",
+        std::format("select {} from MATCHES where tournament_id = $1 and round = $2 order by id", RowMapper<domain::Match>::COLUMNS));
+    // served by the partial match_open_idx, keep the predicate identical to the index definition
+    static inline PreparedStatement& SELECT_LAST_OPEN_MATCH = StatementRegistry::Instance().Declare("select_last_open_match", std::format(R"(
+        select {} from MATCHES
+        where tournament_id = $1 and coalesce(document->>'visitorTeamId', '') = ''
+        order by round desc, created_at desc, id desc limit 1
+    )", RowMapper<domain::Match>::COLUMNS));
 public:
     explicit MatchRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider) : connectionProvider(connectionProvider) {}
 
-    std::shared_ptr<domain::Match> ReadById(std::string id) override {
-        return  nullptr;
+    std::shared_ptr<domain::Match> ReadById(const domain::Id id) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, SELECT_MATCH_BY_ID, pqxx::params{Binary(id)});
+        tx.commit();
+        if (result.empty()) {
+            return nullptr;
+        }
+        auto match = std::make_shared<domain::Match>();
+        RowMapper<domain::Match>::Map(result[0], *match);
+        return match;
     }
-    std::string Create (const domain::Match & entity) override {
-        return  "";
+
+    domain::Id Create (const domain::Match & entity) override {
+        auto pooled = connectionProvider->Connection();
+        const nlohmann::json matchBody = entity;
+
+        pqxx::work tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, INSERT_MATCH, pqxx::params{Binary(entity.TournamentId()), entity.Round(), matchBody.dump()});
+        tx.commit();
+
+        return result[0]["id"].as<domain::Id>();
     }
 
-    std::string Update (const domain::Match & entity) override {
-        return "";
+    std::vector<std::optional<domain::Id>> CreateAll(const std::vector<domain::Match>& entities) override {
+        std::vector<domain::Id> tournamentIds;
+        std::vector<int> rounds;
+        std::vector<std::string> documents;
+        tournamentIds.reserve(entities.size());
+        rounds.reserve(entities.size());
+        documents.reserve(entities.size());
+        for (const auto& match : entities) {
+            tournamentIds.push_back(match.TournamentId());
+            rounds.push_back(match.Round());
+            documents.push_back(nlohmann::json(match).dump());
+        }
+
+        auto pooled = connectionProvider->Connection();
+        pqxx::work tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, INSERT_MATCHES, pqxx::params{tournamentIds, rounds, documents});
+        tx.commit();
+
+        std::vector<std::optional<domain::Id>> ids;
+        ids.reserve(result.size());
+        for (const auto& row : result) {
+            ids.emplace_back(row["id"].as<domain::Id>());
+        }
+        return ids;
+    }
+
+    domain::Id Update (const domain::Match & entity) override {
+        auto pooled = connectionProvider->Connection();
+        const nlohmann::json matchBody = entity;
+
+        pqxx::work tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, UPDATE_MATCH, pqxx::params{Binary(entity.Id()), matchBody.dump()});
+        tx.commit();
+
+        return result.empty() ? domain::Id{} : result[0]["id"].as<domain::Id>();
     }
-    void Delete(std::string id) override {
 
+    void Delete(const domain::Id id) override {
+        auto pooled = connectionProvider->Connection();
+
+        pqxx::work tx(*pooled);
+        Execute(pooled, tx, DELETE_MATCH, pqxx::params{Binary(id)});
+        tx.commit();
     }
 
     std::vector<std::shared_ptr<domain::Match>> ReadAll() override {
-        return std::vector<std::shared_ptr<domain::Match>>();
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = tx.exec(std::format("select {} from MATCHES", RowMapper<domain::Match>::COLUMNS));
+        tx.commit();
+
+        return MapRows<domain::Match>(result);
     }
 
-    std::shared_ptr<domain::Match> FindLastOpenMatch(const std::string_view& tournamentId) override {
-        return  nullptr;
+    Page<domain::Match> ReadPage(const PageRequest& request) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        // one extra row tells whether there is a next page
+        const pqxx::result result = request.after
+            ? Execute(pooled, tx, SELECT_MATCHES_PAGE_AFTER, pqxx::params{request.after->createdAt, request.after->id, request.limit + 1})
+            : Execute(pooled, tx, SELECT_MATCHES_PAGE, pqxx::params{request.limit + 1});
+        tx.commit();
+
+        return MapPage<domain::Match>(result, request.limit);
     }
 
-    std::vector<domain::Match> FindMatchesByTournamentAndRound(const std::string_view& tournamentId) override {
-        return std::vector<domain::Match>();
+    std::shared_ptr<domain::Match> FindLastOpenMatch(const domain::Id& tournamentId) override {
+        // read from the primary, the caller is about to fill the match it gets back
+        auto pooled = connectionProvider->Connection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, SELECT_LAST_OPEN_MATCH, pqxx::params{Binary(tournamentId)});
+        tx.commit();
+        if (result.empty()) {
+            return nullptr;
+        }
+        auto match = std::make_shared<domain::Match>();
+        RowMapper<domain::Match>::Map(result[0], *match);
+        return match;
+    }
+
+    std::vector<domain::Match> FindMatchesByTournamentAndRound(const domain::Id& tournamentId, const int round) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, SELECT_MATCHES_BY_TOURNAMENT_ROUND, pqxx::params{Binary(tournamentId), round});
+        tx.commit();
+
+        std::vector<domain::Match> matches(result.size());
+        for (size_t i = 0; i < result.size(); i++) {
+            RowMapper<domain::Match>::Map(result[i], matches[i]);
+        }
+        return matches;
     }
 };
 
-#endif //TOURNAMENTS_MATCHREPOSITORY_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_MATCHREPOSITORY_HPP
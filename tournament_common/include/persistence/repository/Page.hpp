@@ -0,0 +1,117 @@
+#ifndef COMMON_PAGE_HPP
+#define COMMON_PAGE_HPP
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "domain/Id.hpp"
+
+// Position of the last row of a page in (created_at, id) order
+struct KeysetPosition {
+    std::string createdAt;
+    std::string id;
+};
+
+struct PageRequest {
+    size_t limit = 100;
+    std::optional<KeysetPosition> after;
+};
+
+template<typename Type>
+struct Page {
+    std::vector<std::shared_ptr<Type>> items;
+    std::optional<KeysetPosition> next;
+};
+
+namespace cursor {
+    inline constexpr std::string_view ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    // opaque cursor handed to clients: base64url("<created_at>|<id>") without padding
+    inline std::string Encode(const KeysetPosition& position) {
+        const std::string raw = position.createdAt + "|" + position.id;
+        std::string encoded;
+        encoded.reserve((raw.size() + 2) / 3 * 4);
+        uint32_t buffer = 0;
+        int bits = 0;
+        for (const unsigned char c : raw) {
+            buffer = (buffer << 8) | c;
+            bits += 8;
+            while (bits >= 6) {
+                bits -= 6;
+                encoded += ALPHABET[(buffer >> bits) & 0x3F];
+            }
+        }
+        if (bits > 0) {
+            encoded += ALPHABET[(buffer << (6 - bits)) & 0x3F];
+        }
+        return encoded;
+    }
+
+    namespace detail {
+        inline bool Number(const std::string_view text, const size_t offset, const size_t digits, int& value) {
+            if (offset + digits > text.size()) {
+                return false;
+            }
+            const char* begin = text.data() + offset;
+            const auto [end, error] = std::from_chars(begin, begin + digits, value);
+            return error == std::errc() && end == begin + digits && *begin != '-' && *begin != '+';
+        }
+
+        // created_at::text of a timestamp column: "YYYY-MM-DD HH:MM:SS" with up to 6 fraction digits
+        inline bool ValidTimestamp(const std::string_view text) {
+            int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+            if (text.size() < 19 || text[4] != '-' || text[7] != '-' || text[10] != ' ' || text[13] != ':' || text[16] != ':'
+                || !Number(text, 0, 4, year) || !Number(text, 5, 2, month) || !Number(text, 8, 2, day)
+                || !Number(text, 11, 2, hour) || !Number(text, 14, 2, minute) || !Number(text, 17, 2, second)) {
+                return false;
+            }
+            if (!std::chrono::year_month_day{std::chrono::year(year), std::chrono::month(month), std::chrono::day(day)}.ok()
+                || hour > 23 || minute > 59 || second > 59) {
+                return false;
+            }
+            if (text.size() == 19) {
+                return true;
+            }
+            const auto fraction = text.substr(20);
+            return text[19] == '.' && !fraction.empty() && fraction.size() <= 6
+                && fraction.find_first_not_of("0123456789") == std::string_view::npos;
+        }
+    }
+
+    // nullopt for anything that is not a cursor Encode produced, so a forged one is a 400 and never reaches SQL
+    inline std::optional<KeysetPosition> Decode(const std::string_view& encoded) {
+        std::string raw;
+        raw.reserve(encoded.size() * 3 / 4);
+        uint32_t buffer = 0;
+        int bits = 0;
+        for (const char c : encoded) {
+            const auto value = ALPHABET.find(c);
+            if (value == std::string_view::npos) {
+                return std::nullopt;
+            }
+            buffer = (buffer << 6) | static_cast<uint32_t>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                raw += static_cast<char>((buffer >> bits) & 0xFF);
+            }
+        }
+        const auto separator = raw.find('|');
+        if (separator == std::string::npos) {
+            return std::nullopt;
+        }
+        KeysetPosition position{raw.substr(0, separator), raw.substr(separator + 1)};
+        if (!detail::ValidTimestamp(position.createdAt) || !domain::Id::Parse(position.id)) {
+            return std::nullopt;
+        }
+        return position;
+    }
+}
+
+#endif //COMMON_PAGE_HPP
@@ -0,0 +1,157 @@
+#ifndef COMMON_REQUEST_COALESCER_HPP
+#define COMMON_REQUEST_COALESCER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "configuration/CoalescingConfiguration.hpp"
+#include "domain/Id.hpp"
+#include "domain/Team.hpp"
+
+struct CoalescingStats {
+    std::atomic<uint64_t> requests{0};
+    // requests answered by a read another thread had already queued or started
+    std::atomic<uint64_t> joined{0};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> batchedIds{0};
+};
+
+/**
+ * Single-flight and batching for reads by id. Concurrent reads of the same id share one query;
+ * the first reader of a batch waits up to batchWindow for other ids and reads all of them with
+ * one loader call. Nothing is kept once a batch completes, so this is not a cache: a read always
+ * sees data at least as recent as the moment it was issued, except when it joins a query already
+ * running, which Forget prevents after a write.
+ */
+template<typename Type>
+class RequestCoalescer {
+public:
+    using Loader = std::function<std::vector<std::shared_ptr<Type>>(const std::vector<domain::Id>&)>;
+
+private:
+    struct Flight {
+        std::promise<std::shared_ptr<Type>> promise;
+        std::shared_future<std::shared_ptr<Type>> result = promise.get_future().share();
+    };
+
+    Loader loader;
+    config::CoalescingConfiguration configuration;
+    CoalescingStats stats;
+
+    std::mutex mutex;
+    std::condition_variable batchFull;
+    // queued and running reads that new readers of the same id can join
+    std::unordered_map<domain::Id, std::shared_ptr<Flight>> flights;
+    // the batch that is still collecting ids, owned by the thread that opened it
+    std::vector<std::pair<domain::Id, std::shared_ptr<Flight>>> pending;
+    bool collecting = false;
+
+    static const domain::Id& EntityId(const domain::Team& team) {
+        return team.Id;
+    }
+
+    template<typename Entity>
+    static const domain::Id& EntityId(const Entity& entity) {
+        return entity.Id();
+    }
+
+    // runs outside the lock, every flight of the batch is completed whatever the loader does
+    void Run(const std::vector<std::pair<domain::Id, std::shared_ptr<Flight>>>& batch) {
+        std::vector<domain::Id> ids;
+        ids.reserve(batch.size());
+        for (const auto& [id, flight] : batch) {
+            ids.push_back(id);
+        }
+        stats.batches.fetch_add(1, std::memory_order_relaxed);
+        stats.batchedIds.fetch_add(ids.size(), std::memory_order_relaxed);
+
+        std::unordered_map<domain::Id, std::shared_ptr<Type>> entities;
+        std::exception_ptr error;
+        try {
+            for (auto& entity : loader(ids)) {
+                if (entity != nullptr) {
+                    const domain::Id id = EntityId(*entity);
+                    entities.emplace(id, std::move(entity));
+                }
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            for (const auto& [id, flight] : batch) {
+                if (const auto it = flights.find(id); it != flights.end() && it->second == flight) {
+                    flights.erase(it);
+                }
+            }
+        }
+        for (const auto& [id, flight] : batch) {
+            if (error) {
+                flight->promise.set_exception(error);
+            } else {
+                const auto it = entities.find(id);
+                flight->promise.set_value(it == entities.end() ? nullptr : it->second);
+            }
+        }
+    }
+
+public:
+    RequestCoalescer(Loader loader, const config::CoalescingConfiguration& configuration)
+        : loader(std::move(loader)), configuration(configuration) {}
+
+    // nullptr when there is no entity with that id, loader exceptions reach every reader of the batch
+    std::shared_ptr<Type> Load(const domain::Id& id) {
+        std::unique_lock lock(mutex);
+        stats.requests.fetch_add(1, std::memory_order_relaxed);
+        if (const auto it = flights.find(id); it != flights.end()) {
+            const auto result = it->second->result;
+            stats.joined.fetch_add(1, std::memory_order_relaxed);
+            lock.unlock();
+            // readers that joined get their own copy, the first reader keeps the loaded instance
+            const auto entity = result.get();
+            return entity == nullptr ? nullptr : std::make_shared<Type>(*entity);
+        }
+
+        const auto flight = std::make_shared<Flight>();
+        flights.emplace(id, flight);
+        pending.emplace_back(id, flight);
+        if (collecting) {
+            if (pending.size() >= configuration.maxBatchSize) {
+                batchFull.notify_one();
+            }
+            lock.unlock();
+            return flight->result.get();
+        }
+
+        collecting = true;
+        if (configuration.batchWindow.count() > 0) {
+            batchFull.wait_for(lock, configuration.batchWindow, [this] { return pending.size() >= configuration.maxBatchSize; });
+        }
+        const auto batch = std::exchange(pending, {});
+        collecting = false;
+        lock.unlock();
+
+        Run(batch);
+        return flight->result.get();
+    }
+
+    // readers arriving after a write must not join a query that may have started before it
+    void Forget(const domain::Id& id) {
+        std::lock_guard lock(mutex);
+        flights.erase(id);
+    }
+
+    [[nodiscard]] const CoalescingStats& Stats() const {
+        return stats;
+    }
+};
+
+#endif //COMMON_REQUEST_COALESCER_HPP
@@ -0,0 +1,185 @@
+#ifndef COMMON_ROWMAPPER_HPP
+#define COMMON_ROWMAPPER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pqxx/pqxx>
+
+#include "domain/Group.hpp"
+#include "domain/Match.hpp"
+#include "domain/Team.hpp"
+#include "domain/Tournament.hpp"
+#include "domain/Utilities.hpp"
+#include "persistence/configuration/IdTraits.hpp"
+#include "IVersionRepository.hpp"
+#include "Page.hpp"
+
+/**
+ * Decodes rows straight into domain objects. Every mapper names the columns it reads, in
+ * order, as JSONB paths projected by the query, so the document never gets parsed on this
+ * side. Columns are read by position, queries must select COLUMNS first and may append
+ * their own columns (e.g. created_at for keyset pages) after them. Rows are a pqxx::row or
+ * an AsyncRow, whichever executor ran the query.
+ */
+template<typename Type>
+struct RowMapper;
+
+// id kept inside a JSONB document, where a missing one is null or the "" of the nil id
+template<typename Field>
+domain::Id OptionalId(const Field& field) {
+    return field.is_null() || field.size() == 0 ? domain::Id{} : field.template as<domain::Id>();
+}
+
+template<>
+struct RowMapper<domain::Team> {
+    static constexpr std::string_view COLUMNS =
+        "id, document->>'name' as name, (extract(epoch from coalesce(last_update_date, 'epoch'::timestamp)) * 1000000)::bigint as version";
+
+    template<typename Row>
+    static void Map(const Row& row, domain::Team& team) {
+        team.Id = row[0].template as<domain::Id>();
+        team.Name = row[1].view();
+        team.LastModified = std::chrono::sys_time<std::chrono::microseconds>(std::chrono::microseconds(row[2].template as<int64_t>()));
+    }
+};
+
+template<>
+struct RowMapper<domain::Tournament> {
+    static constexpr std::string_view COLUMNS =
+        "id, document->>'name' as name, "
+        "(document->'format'->>'numberOfGroups')::int as number_of_groups, "
+        "(document->'format'->>'maxTeamsPerGroup')::int as max_teams_per_group, "
+        "document->'format'->>'type' as type";
+
+    template<typename Row>
+    static void Map(const Row& row, domain::Tournament& tournament) {
+        const domain::TournamentFormat defaults;
+        tournament.Id() = row[0].template as<domain::Id>();
+        tournament.Name() = row[1].view();
+        tournament.Format() = domain::TournamentFormat(
+            row[2].is_null() ? defaults.NumberOfGroups() : row[2].template as<int>(),
+            row[3].is_null() ? defaults.MaxTeamsPerGroup() : row[3].template as<int>(),
+            row[4].is_null() ? defaults.Type() : domain::fromString(row[4].view()));
+    }
+};
+
+template<>
+struct RowMapper<domain::Match> {
+    static constexpr std::string_view COLUMNS =
+        "id, tournament_id, round, document->>'homeTeamId' as home_team_id, document->>'visitorTeamId' as visitor_team_id, "
+        "(document->'score'->>'homeTeamScore')::int as home_team_score, "
+        "(document->'score'->>'visitorTeamScore')::int as visitor_team_score";
+
+    template<typename Row>
+    static void Map(const Row& row, domain::Match& match) {
+        match.Id() = row[0].template as<domain::Id>();
+        match.TournamentId() = row[1].template as<domain::Id>();
+        match.Round() = row[2].template as<int>();
+        match.HomeTeamId() = OptionalId(row[3]);
+        match.VisitorTeamId() = OptionalId(row[4]);
+        match.MatchScore().homeTeamScore = row[5].is_null() ? 0 : row[5].template as<int>();
+        match.MatchScore().visitorTeamScore = row[6].is_null() ? 0 : row[6].template as<int>();
+    }
+};
+
+// one row per team of the group, a group without teams comes back as a single row with null team columns
+template<>
+struct RowMapper<domain::Group> {
+    static constexpr std::string_view COLUMNS =
+        "g.id, g.document->>'name' as name, g.tournament_id, t.team->>'id' as team_id, t.team->>'name' as team_name";
+    static constexpr std::string_view FROM =
+        "groups g left join lateral jsonb_array_elements(g.document->'teams') with ordinality t(team, position) on true";
+    // keeps the rows of a group together and its teams in document order
+    static constexpr std::string_view ORDER = "g.id, t.position";
+
+    template<typename Row>
+    static void Map(const Row& row, domain::Group& group) {
+        group.Id() = row[0].template as<domain::Id>();
+        group.Name() = row[1].view();
+        group.TournamentId() = row[2].template as<domain::Id>();
+        AddTeam(row, group);
+    }
+
+    template<typename Row>
+    static bool SameEntity(const Row& row, const domain::Group& group) {
+        return row[0].template as<domain::Id>() == group.Id();
+    }
+
+    template<typename Row>
+    static void AddTeam(const Row& row, domain::Group& group) {
+        if (!row[3].is_null()) {
+            group.Teams().push_back(domain::Team{row[3].template as<domain::Id>(), std::string(row[4].view())});
+        }
+    }
+};
+
+// last_update_date as microseconds since the epoch, of one row or of a COLLECTION_VERSIONS row with its revision
+template<>
+struct RowMapper<ResourceVersion> {
+    static constexpr std::string_view COLUMNS =
+        "(extract(epoch from coalesce(last_update_date, 'epoch'::timestamp)) * 1000000)::bigint as version";
+    static constexpr std::string_view COLLECTION_COLUMNS =
+        "(extract(epoch from last_update_date) * 1000000)::bigint as version, revision";
+
+    template<typename Row>
+    static void Map(const Row& row, ResourceVersion& version) {
+        version.lastModified = std::chrono::sys_time<std::chrono::microseconds>(std::chrono::microseconds(row[0].template as<int64_t>()));
+        version.count = row.size() > 1 ? row[1].template as<int64_t>() : 1;
+    }
+};
+
+/**
+ * Maps every row into one contiguous block and hands out aliasing pointers into it, so a list
+ * costs one allocation instead of one per entity. Holding any element keeps the whole block alive.
+ */
+template<typename Type, typename Result>
+std::vector<std::shared_ptr<Type>> MapRows(const Result& result, const size_t limit = SIZE_MAX) {
+    const size_t count = std::min<size_t>(result.size(), limit);
+    auto block = std::make_shared<std::vector<Type>>(count);
+    std::vector<std::shared_ptr<Type>> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        RowMapper<Type>::Map(result[i], (*block)[i]);
+        entities.emplace_back(block, &(*block)[i]);
+    }
+    return entities;
+}
+
+// keyset page of at most limit rows, queried with one more so a next position is only set when there is a next page
+template<typename Type, typename Result>
+Page<Type> MapPage(const Result& result, const size_t limit) {
+    Page<Type> page;
+    page.items = MapRows<Type>(result, limit);
+    if (result.size() > limit) {
+        const auto last = result[page.items.size() - 1];
+        page.next = KeysetPosition{last["created_at"].c_str(), last["id"].c_str()};
+    }
+    return page;
+}
+
+// groups span several rows, consecutive rows of the same group are folded into one entity
+template<typename Result>
+std::vector<std::shared_ptr<domain::Group>> MapGroupRows(const Result& result) {
+    auto block = std::make_shared<std::vector<domain::Group>>();
+    for (size_t i = 0; i < result.size(); i++) {
+        const auto row = result[i];
+        if (!block->empty() && RowMapper<domain::Group>::SameEntity(row, block->back())) {
+            RowMapper<domain::Group>::AddTeam(row, block->back());
+        } else {
+            RowMapper<domain::Group>::Map(row, block->emplace_back());
+        }
+    }
+
+    std::vector<std::shared_ptr<domain::Group>> groups;
+    groups.reserve(block->size());
+    for (auto& group : *block) {
+        groups.emplace_back(block, &group);
+    }
+    return groups;
+}
+
+#endif //COMMON_ROWMAPPER_HPP
@@ -6,71 +6,234 @@
 #define RESTAPI_TEAMREPOSITORY_HPP
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <format>
+#include <stdexcept>
 #include <nlohmann/json.hpp>
 
 
+#include "persistence/configuration/AsyncQueryExecutor.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
+#include "persistence/configuration/IdTraits.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
 #include "IRepository.hpp"
+#include "IAsyncRepository.hpp"
+#include "IAsyncVersionRepository.hpp"
+#include "IBulkRepository.hpp"
+#include "IBatchRepository.hpp"
+#include "IVersionRepository.hpp"
+#include "RowMapper.hpp"
 #include "domain/Team.hpp"
-#include "domain/Utilities.hpp"
+#include "domain/JsonSerializer.hpp"
 
 
-class TeamRepository : public IRepository<domain::Team, std::string_view> {
+class TeamRepository : public IRepository<domain::Team, domain::Id>, public IBulkRepository<domain::Team>, public IBatchRepository<domain::Team>, public IVersionRepository<domain::Team>,
+                       public IAsyncRepository<domain::Team, domain::Id>, public IAsyncVersionRepository<domain::Team> {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    std::shared_ptr<AsyncQueryExecutor> asyncExecutor;
+
+    static inline PreparedStatement& INSERT_TEAM = StatementRegistry::Instance().Declare(
+        "insert_team", "insert into TEAMS (document) values($1) RETURNING id");
+    static inline PreparedStatement& SELECT_TEAM_BY_ID = StatementRegistry::Instance().Declare(
+        "select_team_by_id", std::format("select {} from TEAMS where id = $1", RowMapper<domain::Team>::COLUMNS));
+    static inline PreparedStatement& SELECT_TEAMS_PAGE = StatementRegistry::Instance().Declare(
+        "select_teams_page", std::format("select {}, created_at::text as created_at from TEAMS order by created_at, id limit $1", RowMapper<domain::Team>::COLUMNS));
+    static inline PreparedStatement& SELECT_TEAMS_PAGE_AFTER = StatementRegistry::Instance().Declare("select_teams_page_after", std::format(R"(
+        select {}, created_at::text as created_at from TEAMS
+        where (created_at, id) > ($1::timestamp, $2::uuid)
+        order by created_at, id limit $3
+    )", RowMapper<domain::Team>::COLUMNS));
+    static inline PreparedStatement& SELECT_TEAM_VERSION = StatementRegistry::Instance().Declare(
+        "select_team_version", std::format("select {} from TEAMS where id = $1", RowMapper<ResourceVersion>::COLUMNS));
+    static inline PreparedStatement& SELECT_TEAMS_VERSION = StatementRegistry::Instance().Declare(
+        "select_teams_version", std::format("select {} from COLLECTION_VERSIONS where name = 'teams'", RowMapper<ResourceVersion>::COLLECTION_COLUMNS));
+    static inline PreparedStatement& SELECT_TEAMS_BY_IDS = StatementRegistry::Instance().Declare(
+        "select_teams_by_ids", std::format("select {} from TEAMS where id = ANY($1::uuid[])", RowMapper<domain::Team>::COLUMNS));
 public:
 
-    explicit TeamRepository(std::shared_ptr<IDbConnectionProvider> connectionProvider) : connectionProvider(std::move(connectionProvider)){}
+    // without an executor the async reads complete as unavailable
+    TeamRepository(std::shared_ptr<IDbConnectionProvider> connectionProvider, std::shared_ptr<AsyncQueryExecutor> asyncExecutor)
+        : connectionProvider(std::move(connectionProvider)), asyncExecutor(std::move(asyncExecutor)) {}
 
     std::vector<std::shared_ptr<domain::Team>> ReadAll() override {
         std::vector<std::shared_ptr<domain::Team>> teams;
 
-        auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+        auto pooled = connectionProvider->ReadConnection();
         
-        pqxx::work tx(*(connection->connection));
+        pqxx::read_transaction tx(*pooled);
         pqxx::result result{tx.exec("select id, document->>'name' as name from teams")};
         tx.commit();
 
         for(auto row : result){
-            teams.push_back(std::make_shared<domain::Team>(domain::Team{row["id"].c_str(), row["name"].c_str()}));
+            teams.push_back(std::make_shared<domain::Team>(domain::Team{row["id"].as<domain::Id>(), row["name"].c_str()}));
         }
 
         return teams;
     }
 
-    std::shared_ptr<domain::Team> ReadById(std::string_view id) override {
-        auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    Page<domain::Team> ReadPage(const PageRequest& request) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        // one extra row tells whether there is a next page
+        const pqxx::result result = request.after
+            ? Execute(pooled, tx, SELECT_TEAMS_PAGE_AFTER, pqxx::params{request.after->createdAt, request.after->id, request.limit + 1})
+            : Execute(pooled, tx, SELECT_TEAMS_PAGE, pqxx::params{request.limit + 1});
+        tx.commit();
+
+        return MapPage<domain::Team>(result, request.limit);
+    }
+
+    void ReadPageAsync(const PageRequest& request, const deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Team>> completion) override {
+        AsyncQuery query = request.after
+            ? AsyncQuery{&SELECT_TEAMS_PAGE_AFTER, {request.after->createdAt, request.after->id, std::to_string(request.limit + 1)}, deadline}
+            : AsyncQuery{&SELECT_TEAMS_PAGE, {std::to_string(request.limit + 1)}, deadline};
+        SubmitMapped(asyncExecutor, std::move(query), std::move(completion), [limit = request.limit](const AsyncRows& rows) {
+            return MapPage<domain::Team>(rows, limit);
+        });
+    }
 
-        pqxx::work tx(*(connection->connection));
-        pqxx::result result = tx.exec(pqxx::prepped{"select_team_by_id"}, id.data());
+    std::shared_ptr<domain::Team> ReadById(const domain::Id id) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        pqxx::result result = Execute(pooled, tx, SELECT_TEAM_BY_ID, pqxx::params{Binary(id)});
         tx.commit();
-        auto team = std::make_shared<domain::Team>( nlohmann::json::parse(result[0]["document"].c_str()));
-        team->Id = result[0]["id"].c_str();
+        if (result.empty()) {
+            return nullptr;
+        }
+        auto team = std::make_shared<domain::Team>();
+        RowMapper<domain::Team>::Map(result[0], *team);
 
         return team;
     }
 
-    std::string_view Create(const domain::Team &entity) override {
+    void ReadByIdAsync(const domain::Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Team>> completion) override {
+        SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_TEAM_BY_ID, {AsyncParam(id)}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+            std::shared_ptr<domain::Team> team;
+            if (!rows.empty()) {
+                team = std::make_shared<domain::Team>();
+                RowMapper<domain::Team>::Map(rows[0], *team);
+            }
+            return team;
+        });
+    }
+
+    std::optional<ResourceVersion> ReadVersion(const domain::Id& id) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, SELECT_TEAM_VERSION, pqxx::params{Binary(id)});
+        tx.commit();
+
+        if (result.empty()) {
+            return std::nullopt;
+        }
+        ResourceVersion version;
+        RowMapper<ResourceVersion>::Map(result[0], version);
+        return version;
+    }
+
+    void ReadVersionAsync(const domain::Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) override {
+        SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_TEAM_VERSION, {AsyncParam(id)}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+            std::optional<ResourceVersion> version;
+            if (!rows.empty()) {
+                RowMapper<ResourceVersion>::Map(rows[0], version.emplace());
+            }
+            return version;
+        });
+    }
+
+    ResourceVersion ReadCollectionVersion() override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, SELECT_TEAMS_VERSION, pqxx::params{});
+        tx.commit();
+
+        ResourceVersion version;
+        RowMapper<ResourceVersion>::Map(result[0], version);
+        return version;
+    }
+
+    void ReadCollectionVersionAsync(const deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) override {
+        SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_TEAMS_VERSION, {}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+            if (rows.empty()) {
+                throw std::runtime_error("COLLECTION_VERSIONS has no teams row");
+            }
+            ResourceVersion version;
+            RowMapper<ResourceVersion>::Map(rows[0], version);
+            return version;
+        });
+    }
+
+    std::vector<std::shared_ptr<domain::Team>> ReadByIds(const std::vector<domain::Id>& ids) override {
+        auto pooled = connectionProvider->ReadConnection();
+
+        pqxx::read_transaction tx(*pooled);
+        const pqxx::result result = Execute(pooled, tx, SELECT_TEAMS_BY_IDS, pqxx::params{ids});
+        tx.commit();
+
+        return MapRows<domain::Team>(result);
+    }
+
+    domain::Id Create(const domain::Team &entity) override {
         auto pooled = connectionProvider->Connection();
-        auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
         nlohmann::json teamBody = entity;
 
-        pqxx::work tx(*(connection->connection));
-        pqxx::result result = tx.exec(pqxx::prepped{"insert_team"}, teamBody.dump());
+        pqxx::work tx(*pooled);
+        pqxx::result result = Execute(pooled, tx, INSERT_TEAM, pqxx::params{teamBody.dump()});
+
+        tx.commit();
+
+        return result[0]["id"].as<domain::Id>();
+    }
+
+    std::vector<std::optional<domain::Id>> CreateAll(const std::vector<domain::Team>& entities) override {
+        auto pooled = connectionProvider->Connection();
+        pqxx::work tx(*pooled);
 
+        tx.exec("create temp table if not exists teams_staging (ord int not null, document jsonb not null) on commit delete rows");
+        auto stream = pqxx::stream_to::table(tx, {"teams_staging"}, {"ord", "document"});
+        for (size_t i = 0; i < entities.size(); i++) {
+            stream.write_values(static_cast<int>(i), nlohmann::json{{"name", entities[i].Name}}.dump());
+        }
+        stream.complete();
+
+        // first occurrence of every name is inserted, later ones and names already stored come back without id
+        const pqxx::result result = tx.exec(R"(
+            with candidates as (
+                select distinct on (document->>'name') ord, document
+                from teams_staging
+                order by document->>'name', ord
+            ), inserted as (
+                insert into teams (document)
+                select document from candidates order by ord
+                on conflict ((document->>'name')) do nothing
+                returning id, document->>'name' as name
+            )
+            select s.ord, i.id
+            from teams_staging s
+            left join candidates c on c.ord = s.ord
+            left join inserted i on i.name = c.document->>'name'
+            order by s.ord
+        )");
         tx.commit();
 
-        return result[0]["id"].c_str();
+        std::vector<std::optional<domain::Id>> ids;
+        ids.reserve(result.size());
+        for (const auto& row : result) {
+            ids.push_back(row["id"].as<std::optional<domain::Id>>());
+        }
+        return ids;
     }
 
-    std::string_view Update(const domain::Team &entity) override {
-        return "newID";
+    domain::Id Update(const domain::Team &entity) override {
+        return entity.Id;
     }
 
 
-    void Delete(std::string_view id) override{
+    void Delete(domain::Id id) override{
         
     }
 };
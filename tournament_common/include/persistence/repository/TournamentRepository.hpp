@@ -7,19 +7,37 @@
 #include <string>
 
 #include "IRepository.hpp"
+#include "IAsyncRepository.hpp"
+#include "IAsyncVersionRepository.hpp"
+#include "IBatchRepository.hpp"
+#include "IOutboxRepository.hpp"
+#include "IVersionRepository.hpp"
 #include "domain/Tournament.hpp"
+#include "persistence/configuration/AsyncQueryExecutor.hpp"
 #include "persistence/configuration/IDbConnectionProvider.hpp"
 
 
-class TournamentRepository : public IRepository<domain::Tournament, std::string> {
+class TournamentRepository : public IRepository<domain::Tournament, domain::Id>, public IBatchRepository<domain::Tournament>, public IOutboxRepository<domain::Tournament>, public IVersionRepository<domain::Tournament>,
+                             public IAsyncRepository<domain::Tournament, domain::Id>, public IAsyncVersionRepository<domain::Tournament> {
     std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    std::shared_ptr<AsyncQueryExecutor> asyncExecutor;
 public:
-    explicit TournamentRepository(std::shared_ptr<IDbConnectionProvider> connectionProvider);
-    std::shared_ptr<domain::Tournament> ReadById(std::string id) override;
-    std::string Create (const domain::Tournament & entity) override;
-    std::string Update (const domain::Tournament & entity) override;
-    void Delete(std::string id) override;
+    // without an executor the async reads complete as unavailable
+    TournamentRepository(std::shared_ptr<IDbConnectionProvider> connectionProvider, std::shared_ptr<AsyncQueryExecutor> asyncExecutor);
+    std::shared_ptr<domain::Tournament> ReadById(domain::Id id) override;
+    void ReadByIdAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Tournament>> completion) override;
+    domain::Id Create (const domain::Tournament & entity) override;
+    domain::Id CreateWithEvent(const domain::Tournament& entity, std::string_view queue) override;
+    domain::Id Update (const domain::Tournament & entity) override;
+    void Delete(domain::Id id) override;
     std::vector<std::shared_ptr<domain::Tournament>> ReadAll() override;
+    std::vector<std::shared_ptr<domain::Tournament>> ReadByIds(const std::vector<domain::Id>& ids) override;
+    Page<domain::Tournament> ReadPage(const PageRequest& request) override;
+    void ReadPageAsync(const PageRequest& request, deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Tournament>> completion) override;
+    std::optional<ResourceVersion> ReadVersion(const domain::Id& id) override;
+    void ReadVersionAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) override;
+    ResourceVersion ReadCollectionVersion() override;
+    void ReadCollectionVersionAsync(deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) override;
 };
 
 #endif //TOURNAMENTS_TOURNAMENTREPOSITORY_HPP
\ No newline at end of file
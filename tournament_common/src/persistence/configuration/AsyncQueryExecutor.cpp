@@ -0,0 +1,507 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <print>
+#include <stdexcept>
+#include <thread>
+#include <libpq-fe.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "persistence/configuration/AsyncQueryExecutor.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+
+bool AsyncField::is_null() const {
+    return PQgetisnull(result, row, column) == 1;
+}
+
+size_t AsyncField::size() const {
+    return static_cast<size_t>(PQgetlength(result, row, column));
+}
+
+const char* AsyncField::c_str() const {
+    return PQgetvalue(result, row, column);
+}
+
+size_t AsyncRow::size() const {
+    return static_cast<size_t>(PQnfields(result));
+}
+
+AsyncField AsyncRow::operator[](const char* column) const {
+    const int number = PQfnumber(result, column);
+    if (number < 0) {
+        throw std::out_of_range(std::format("Unknown column {}", column));
+    }
+    return {result, row, number};
+}
+
+AsyncRows::AsyncRows(pg_result* result) : result(result, PQclear) {}
+
+size_t AsyncRows::size() const {
+    return result ? static_cast<size_t>(PQntuples(result.get())) : 0;
+}
+
+namespace {
+    constexpr auto RECONNECT_INTERVAL = std::chrono::seconds(1);
+    // PQconnectPoll leaves timing out to the caller
+    constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(5);
+    // sent right before a query, the sync after the query ends the implicit transaction and with it the timeout
+    constexpr const char* SET_STATEMENT_TIMEOUT = "select set_config('statement_timeout', $1, true)";
+
+    enum class State { DISCONNECTED, CONNECTING, READY };
+
+    struct Pending {
+        AsyncQuery query;
+        AsyncQueryExecutor::Callback callback;
+        std::chrono::steady_clock::time_point sent;
+        // commands sent before the sync: the prepare and the statement_timeout when needed, then the statement
+        int commands = 1;
+        int finished = 0;
+        // the current command returned a result, so the null result that follows ends it
+        bool commandStarted = false;
+        bool preparing = false;
+        bool prepareFailed = false;
+        PGresult* result = nullptr;
+        // first command that failed, the ones after it come back aborted
+        PGresult* failure = nullptr;
+    };
+
+    struct PipelinedConnection {
+        PGconn* conn = nullptr;
+        State state = State::DISCONNECTED;
+        // what PQconnectPoll waits for while CONNECTING
+        PostgresPollingStatusType polling = PGRES_POLLING_WRITING;
+        std::chrono::steady_clock::time_point connectStarted;
+        std::deque<Pending> pending;
+        // indexed by PreparedStatement::Index(), as PostgresConnection::prepared
+        std::vector<bool> prepared;
+        bool wantsWrite = false;
+    };
+
+    void Deliver(const AsyncQueryExecutor::Callback& callback, AsyncResult result) {
+        try {
+            callback(std::move(result));
+        } catch (const std::exception& e) {
+            std::println("Async query callback failed: {}", e.what());
+        } catch (...) {
+            std::println("Async query callback failed");
+        }
+    }
+
+    void Fail(const AsyncQueryExecutor::Callback& callback, const AsyncError::Kind kind, std::string message) {
+        Deliver(callback, std::unexpected(AsyncError{kind, std::move(message)}));
+    }
+
+    // the configured session timeout, lowered to what is left of the query's deadline
+    std::optional<std::chrono::milliseconds> StatementTimeout(const AsyncQuery& query, const std::chrono::milliseconds configured,
+                                                              const deadline::Clock::time_point now) {
+        std::optional<std::chrono::milliseconds> timeout;
+        if (configured.count() > 0) {
+            timeout = configured;
+        }
+        if (query.deadline != deadline::Clock::time_point::max()) {
+            // rounded up, 0 would disable the timeout altogether
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(query.deadline - now);
+            if (!timeout || remaining < *timeout) {
+                timeout = remaining;
+            }
+        }
+        return timeout;
+    }
+}
+
+struct AsyncQueryExecutor::EventLoop {
+    const config::DatabaseConfiguration& configuration;
+    std::mutex mutex;
+    std::deque<std::pair<AsyncQuery, Callback>> submitted;
+    std::deque<std::pair<AsyncQuery, Callback>> backlog;
+    std::vector<PipelinedConnection> connections;
+    std::chrono::steady_clock::time_point lastConnectAttempt{};
+    std::atomic<bool> running{true};
+    int wakeFd;
+    std::thread thread;
+
+    explicit EventLoop(const config::DatabaseConfiguration& configuration)
+        : configuration(configuration), connections(std::max<size_t>(1, configuration.async.connectionsPerLoop)), wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        thread = std::thread([this] { Run(); });
+    }
+
+    ~EventLoop() {
+        running.store(false);
+        Wake();
+        thread.join();
+        close(wakeFd);
+    }
+
+    void Wake() const {
+        const uint64_t one = 1;
+        [[maybe_unused]] auto written = write(wakeFd, &one, sizeof(one));
+    }
+
+    void Connect() {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastConnectAttempt < RECONNECT_INTERVAL) {
+            return;
+        }
+        lastConnectAttempt = now;
+        for (auto& connection : connections) {
+            if (connection.state != State::DISCONNECTED) {
+                continue;
+            }
+            // returns once the host name is resolved, the handshake is stepped through by Advance
+            PGconn* conn = PQconnectStart(configuration.connectionString.c_str());
+            if (conn == nullptr || PQstatus(conn) == CONNECTION_BAD) {
+                std::println("Async connection failed: {}", conn != nullptr ? PQerrorMessage(conn) : "out of memory");
+                PQfinish(conn);
+                continue;
+            }
+            connection.conn = conn;
+            connection.state = State::CONNECTING;
+            connection.polling = PGRES_POLLING_WRITING;
+            connection.connectStarted = now;
+        }
+    }
+
+    void Advance(PipelinedConnection& connection) {
+        connection.polling = PQconnectPoll(connection.conn);
+        if (connection.polling == PGRES_POLLING_OK) {
+            if (PQsetnonblocking(connection.conn, 1) != 0 || PQenterPipelineMode(connection.conn) != 1) {
+                std::println("Async connection failed: {}", PQerrorMessage(connection.conn));
+                Disconnect(connection);
+                return;
+            }
+            connection.state = State::READY;
+        } else if (connection.polling == PGRES_POLLING_FAILED) {
+            std::println("Async connection failed: {}", PQerrorMessage(connection.conn));
+            Disconnect(connection);
+        }
+    }
+
+    void Disconnect(PipelinedConnection& connection) {
+        const std::string error = PQerrorMessage(connection.conn);
+        // moved out first, the callbacks may submit again
+        auto lost = std::move(connection.pending);
+        connection.pending.clear();
+        connection.prepared.clear();
+        connection.wantsWrite = false;
+        PQfinish(connection.conn);
+        connection.conn = nullptr;
+        connection.state = State::DISCONNECTED;
+
+        for (auto& pending : lost) {
+            PQclear(pending.result);
+            PQclear(pending.failure);
+            pending.query.statement->Record(std::chrono::steady_clock::now() - pending.sent, true);
+            Fail(pending.callback, AsyncError::Kind::UNAVAILABLE, std::format("connection lost: {}", error));
+        }
+    }
+
+    PipelinedConnection* LeastLoaded() {
+        PipelinedConnection* target = nullptr;
+        for (auto& connection : connections) {
+            if (connection.state == State::READY && connection.pending.size() < configuration.async.maxInFlightPerConnection
+                && (target == nullptr || connection.pending.size() < target->pending.size())) {
+                target = &connection;
+            }
+        }
+        return target;
+    }
+
+    void Expire(const deadline::Clock::time_point now) {
+        std::vector<std::pair<AsyncQuery, Callback>> expired;
+        for (auto it = backlog.begin(); it != backlog.end();) {
+            if (it->first.deadline <= now) {
+                expired.push_back(std::move(*it));
+                it = backlog.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (auto& [query, callback] : expired) {
+            Fail(callback, AsyncError::Kind::DEADLINE, std::format("{} not sent before the request deadline", query.statement->Name()));
+        }
+    }
+
+    void Dispatch() {
+        {
+            std::lock_guard lock(mutex);
+            std::ranges::move(submitted, std::back_inserter(backlog));
+            submitted.clear();
+        }
+
+        const auto now = deadline::Clock::now();
+        Expire(now);
+        while (!backlog.empty()) {
+            PipelinedConnection* connection = LeastLoaded();
+            if (connection == nullptr) {
+                break;
+            }
+            auto [query, callback] = std::move(backlog.front());
+            backlog.pop_front();
+            Send(*connection, std::move(query), std::move(callback), now);
+        }
+
+        // nothing to send on and nothing about to be, do not keep callers waiting for a database that is down
+        if (!backlog.empty() && std::ranges::none_of(connections, [](const auto& connection) { return connection.state != State::DISCONNECTED; })) {
+            auto unavailable = std::move(backlog);
+            backlog.clear();
+            for (auto& [query, callback] : unavailable) {
+                Fail(callback, AsyncError::Kind::UNAVAILABLE, "no database connection available");
+            }
+        }
+
+        for (auto& connection : connections) {
+            if (connection.state == State::READY) {
+                Flush(connection);
+            }
+        }
+    }
+
+    void Send(PipelinedConnection& connection, AsyncQuery query, Callback callback, const deadline::Clock::time_point now) {
+        PreparedStatement& statement = *query.statement;
+        Pending pending{std::move(query), std::move(callback)};
+        PGconn* conn = connection.conn;
+
+        bool sent = true;
+        if (statement.Index() >= connection.prepared.size()) {
+            connection.prepared.resize(statement.Index() + 1, false);
+        }
+        if (!connection.prepared[statement.Index()]) {
+            sent = PQsendPrepare(conn, statement.Name().c_str(), statement.Sql().c_str(), 0, nullptr) == 1;
+            // queries queued behind this one can count on it, Complete takes it back if it fails
+            connection.prepared[statement.Index()] = true;
+            pending.preparing = true;
+            pending.commands++;
+        }
+        if (const auto timeout = StatementTimeout(pending.query, configuration.statementTimeout, now); sent && timeout) {
+            const std::string millis = std::to_string(timeout->count());
+            const char* values[] = {millis.c_str()};
+            sent = PQsendQueryParams(conn, SET_STATEMENT_TIMEOUT, 1, nullptr, values, nullptr, nullptr, 0) == 1;
+            pending.commands++;
+        }
+        if (sent) {
+            const auto& params = pending.query.params;
+            std::vector<const char*> values;
+            std::vector<int> lengths;
+            std::vector<int> formats;
+            values.reserve(params.size());
+            lengths.reserve(params.size());
+            formats.reserve(params.size());
+            for (const auto& param : params) {
+                values.push_back(param.value ? param.value->c_str() : nullptr);
+                lengths.push_back(param.value ? static_cast<int>(param.value->size()) : 0);
+                formats.push_back(param.binary ? 1 : 0);
+            }
+            sent = PQsendQueryPrepared(conn, statement.Name().c_str(), static_cast<int>(params.size()), values.data(), lengths.data(), formats.data(), 0) == 1
+                && PQpipelineSync(conn) == 1;
+        }
+        if (!sent) {
+            Fail(pending.callback, AsyncError::Kind::UNAVAILABLE, PQerrorMessage(conn));
+            Disconnect(connection);
+            return;
+        }
+        pending.sent = std::chrono::steady_clock::now();
+        connection.pending.push_back(std::move(pending));
+    }
+
+    void Flush(PipelinedConnection& connection) {
+        const int flushed = PQflush(connection.conn);
+        if (flushed < 0) {
+            Disconnect(connection);
+        } else {
+            connection.wantsWrite = flushed == 1;
+        }
+    }
+
+    static void Keep(Pending& pending, PGresult* result) {
+        const auto status = PQresultStatus(result);
+        const bool succeeded = status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK;
+        if (!succeeded && pending.preparing && pending.finished == 0) {
+            pending.prepareFailed = true;
+        }
+        if (succeeded && pending.finished == pending.commands - 1 && pending.result == nullptr) {
+            pending.result = result;
+        } else if (!succeeded && status != PGRES_PIPELINE_ABORTED && pending.failure == nullptr) {
+            pending.failure = result;
+        } else {
+            PQclear(result);
+        }
+    }
+
+    static void Complete(PipelinedConnection& connection, Pending& pending) {
+        PreparedStatement& statement = *pending.query.statement;
+        if (pending.prepareFailed) {
+            // prepared again by the next query that runs it on this connection
+            connection.prepared[statement.Index()] = false;
+        }
+        statement.Record(std::chrono::steady_clock::now() - pending.sent, pending.failure != nullptr || pending.result == nullptr);
+
+        AsyncResult outcome = std::unexpected(AsyncError{AsyncError::Kind::QUERY, "query returned no result"});
+        if (pending.failure != nullptr) {
+            const char* sqlstate = PQresultErrorField(pending.failure, PG_DIAG_SQLSTATE);
+            if (sqlstate != nullptr && QUERY_CANCELED == sqlstate && pending.query.deadline != deadline::Clock::time_point::max()) {
+                outcome = std::unexpected(AsyncError{AsyncError::Kind::DEADLINE, std::format("{} cancelled at the request deadline", statement.Name())});
+            } else {
+                outcome = std::unexpected(AsyncError{AsyncError::Kind::QUERY, PQresultErrorMessage(pending.failure)});
+            }
+            PQclear(pending.failure);
+            PQclear(pending.result);
+        } else if (pending.result != nullptr) {
+            outcome = AsyncRows(pending.result);
+        }
+        pending.failure = nullptr;
+        pending.result = nullptr;
+        Deliver(pending.callback, std::move(outcome));
+    }
+
+    void ReadResults(PipelinedConnection& connection) {
+        if (PQconsumeInput(connection.conn) != 1) {
+            Disconnect(connection);
+            return;
+        }
+        // per command its results and a null result, per query the sync after its last command
+        while (!connection.pending.empty() && PQisBusy(connection.conn) == 0) {
+            Pending& pending = connection.pending.front();
+            PGresult* result = PQgetResult(connection.conn);
+            if (pending.finished < pending.commands) {
+                if (result == nullptr) {
+                    if (!pending.commandStarted) {
+                        break;
+                    }
+                    pending.finished++;
+                    pending.commandStarted = false;
+                } else {
+                    pending.commandStarted = true;
+                    Keep(pending, result);
+                }
+                continue;
+            }
+            if (result == nullptr) {
+                break;
+            }
+            const bool synced = PQresultStatus(result) == PGRES_PIPELINE_SYNC;
+            PQclear(result);
+            if (synced) {
+                Pending done = std::move(pending);
+                connection.pending.pop_front();
+                Complete(connection, done);
+            }
+        }
+    }
+
+    // until the next reconnect attempt, connect timeout or backlog deadline, -1 when there is none
+    int PollTimeout() {
+        const auto now = std::chrono::steady_clock::now();
+        std::optional<std::chrono::steady_clock::duration> wait;
+        const auto sooner = [&wait](const std::chrono::steady_clock::duration candidate) {
+            wait = wait ? std::min(*wait, candidate) : candidate;
+        };
+        for (const auto& connection : connections) {
+            if (connection.state == State::DISCONNECTED) {
+                sooner(lastConnectAttempt + RECONNECT_INTERVAL - now);
+            } else if (connection.state == State::CONNECTING) {
+                sooner(connection.connectStarted + CONNECT_TIMEOUT - now);
+            }
+        }
+        for (const auto& [query, callback] : backlog) {
+            if (query.deadline != deadline::Clock::time_point::max()) {
+                sooner(query.deadline - now);
+            }
+        }
+        if (!wait) {
+            return -1;
+        }
+        return static_cast<int>(std::max<int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(*wait).count()));
+    }
+
+    void Run() {
+        std::vector<pollfd> fds;
+        while (running.load()) {
+            const auto now = std::chrono::steady_clock::now();
+            for (auto& connection : connections) {
+                if (connection.state == State::CONNECTING && now - connection.connectStarted >= CONNECT_TIMEOUT) {
+                    std::println("Async connection timed out");
+                    Disconnect(connection);
+                }
+            }
+            if (std::ranges::any_of(connections, [](const auto& connection) { return connection.state == State::DISCONNECTED; })) {
+                Connect();
+            }
+            Dispatch();
+
+            fds.clear();
+            fds.push_back({wakeFd, POLLIN, 0});
+            for (const auto& connection : connections) {
+                short events = 0;
+                if (connection.state == State::CONNECTING) {
+                    events = connection.polling == PGRES_POLLING_READING ? POLLIN : POLLOUT;
+                } else if (connection.state == State::READY) {
+                    events = static_cast<short>(POLLIN | (connection.wantsWrite ? POLLOUT : 0));
+                }
+                fds.push_back({connection.conn != nullptr ? PQsocket(connection.conn) : -1, events, 0});
+            }
+            if (poll(fds.data(), fds.size(), PollTimeout()) < 0) {
+                continue;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                uint64_t wakeups;
+                [[maybe_unused]] auto drained = ::read(wakeFd, &wakeups, sizeof(wakeups));
+            }
+            for (size_t i = 0; i < connections.size(); i++) {
+                auto& connection = connections[i];
+                const short events = fds[i + 1].revents;
+                if (events == 0 || connection.state == State::DISCONNECTED) {
+                    continue;
+                }
+                if (connection.state == State::CONNECTING) {
+                    Advance(connection);
+                    continue;
+                }
+                if (events & POLLOUT) {
+                    Flush(connection);
+                }
+                if (connection.state == State::READY && (events & (POLLIN | POLLERR | POLLHUP))) {
+                    ReadResults(connection);
+                }
+            }
+        }
+
+        for (auto& [query, callback] : backlog) {
+            Fail(callback, AsyncError::Kind::UNAVAILABLE, "async executor stopped");
+        }
+        {
+            std::lock_guard lock(mutex);
+            for (auto& [query, callback] : submitted) {
+                Fail(callback, AsyncError::Kind::UNAVAILABLE, "async executor stopped");
+            }
+        }
+        for (auto& connection : connections) {
+            if (connection.state != State::DISCONNECTED) {
+                Disconnect(connection);
+            }
+        }
+    }
+};
+
+AsyncQueryExecutor::AsyncQueryExecutor(const config::DatabaseConfiguration& configuration) : configuration(configuration) {
+    const size_t loopCount = std::max<size_t>(1, this->configuration.async.eventLoops);
+    loops.reserve(loopCount);
+    for (size_t i = 0; i < loopCount; i++) {
+        loops.push_back(std::make_unique<EventLoop>(this->configuration));
+    }
+}
+
+AsyncQueryExecutor::~AsyncQueryExecutor() = default;
+
+void AsyncQueryExecutor::Submit(AsyncQuery query, Callback callback) {
+    auto& loop = *loops[nextLoop.fetch_add(1, std::memory_order_relaxed) % loops.size()];
+    {
+        std::lock_guard lock(loop.mutex);
+        loop.submitted.emplace_back(std::move(query), std::move(callback));
+    }
+    loop.Wake();
+}
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <format>
+#include <print>
+#include <thread>
+
+#include "persistence/configuration/PostgresConnectionProvider.hpp"
+#include "configuration/StartupReport.hpp"
+
+namespace {
+    // opening a connection is mostly waiting on the network, more warmers than cores is fine
+    constexpr size_t MAX_WARMERS = 16;
+    constexpr auto WARMUP_RETRY_INTERVAL = std::chrono::seconds(1);
+
+    // every thread gets a stable slot the first time it asks for a connection
+    std::atomic<size_t> nextThreadSlot{0};
+    thread_local const size_t threadSlot = nextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+}
+
+PostgresConnectionProvider::PostgresConnectionProvider(const config::DatabaseConfiguration& configuration, const std::string& poolName)
+    : configuration(configuration),
+      acquireLatency(metrics::Registry::Instance().GetHistogram("db_pool_acquire_seconds", "Time spent getting a connection from the pool", {{"pool", poolName}})),
+      acquireTimeouts(metrics::Registry::Instance().GetCounter("db_pool_acquire_timeouts_total", "Requests that gave up waiting for a connection", {{"pool", poolName}})),
+      readyConnections(std::min(configuration.readyPoolSize, configuration.minPoolSize)) {
+    size_t shardCount = configuration.poolShards;
+    if (shardCount == 0) {
+        shardCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    shardCount = std::clamp<size_t>(shardCount, 1, std::max<size_t>(1, configuration.maxPoolSize));
+
+    slots.reserve(configuration.maxPoolSize);
+    spare.reserve(configuration.maxPoolSize);
+    for (size_t i = 0; i < configuration.maxPoolSize; i++) {
+        slots.push_back(std::make_unique<PostgresConnection>(PostgresConnection{nullptr, this}));
+        spare.push_back(slots.back().get());
+    }
+
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; i++) {
+        shards.push_back(std::make_unique<Shard>());
+        shards.back()->idle.reserve(configuration.maxPoolSize);
+    }
+
+    RegisterSamplers(poolName);
+
+    const size_t warmerCount = std::min(configuration.minPoolSize, MAX_WARMERS);
+    warmers.reserve(warmerCount);
+    for (size_t i = 0; i < warmerCount; i++) {
+        warmers.emplace_back([this](const std::stop_token& stop) { WarmUp(stop); });
+    }
+}
+
+void PostgresConnectionProvider::WarmUp(const std::stop_token& stop) {
+    // copied out so the registry lock is not held across round trips
+    std::vector<const PreparedStatement*> statements;
+    StatementRegistry::Instance().ForEach([&statements](const PreparedStatement& statement) { statements.push_back(&statement); });
+
+    while (!stop.stop_requested() && nextWarmup.fetch_add(1, std::memory_order_relaxed) < configuration.minPoolSize) {
+        bool warmed = false;
+        while (!warmed && !stop.stop_requested()) {
+            try {
+                PostgresConnection* slot = TryGrow();
+                if (slot == nullptr) {
+                    // requests already opened every connection the pool may hold, Ready() counts those
+                    return;
+                }
+                // handing the slot back through PooledConnection parks it in an idle shard
+                PooledConnection pooled(slot);
+                for (const auto* statement : statements) {
+                    try {
+                        pooled.Prepare(*statement);
+                    } catch (const pqxx::sql_error& e) {
+                        // left to fail where it is executed, with the request that needs it
+                        std::println("Could not prepare {}: {}", statement->Name(), e.what());
+                    }
+                }
+                warmed = true;
+            } catch (const std::exception& e) {
+                std::println("Database warm-up failed, retrying: {}", e.what());
+                std::unique_lock lock(warmupMutex);
+                warmupRetry.wait_for(lock, stop, WARMUP_RETRY_INTERVAL, [] { return false; });
+            }
+        }
+        if (warmed && warmedConnections.fetch_add(1, std::memory_order_acq_rel) + 1 == readyConnections) {
+            config::StartupReport::Instance().Mark(std::format("database pool ready with {} connections", readyConnections));
+        }
+    }
+}
+
+void PostgresConnectionProvider::RegisterSamplers(const std::string& poolName) {
+    auto& registry = metrics::Registry::Instance();
+    const metrics::Labels labels{{"pool", poolName}};
+    samplers.push_back(registry.Sample("db_pool_open_connections", "Connections currently open", metrics::Type::GAUGE, labels,
+        [this] { return static_cast<double>(openConnections.load(std::memory_order_relaxed)); }));
+    samplers.push_back(registry.Sample("db_pool_busy_connections", "Open connections handed out to a request", metrics::Type::GAUGE, labels,
+        [this] {
+            // read apart, so the two may disagree for a moment while a connection changes hands
+            const size_t idle = IdleConnections();
+            const size_t open = openConnections.load(std::memory_order_relaxed);
+            return static_cast<double>(open > idle ? open - idle : 0);
+        }));
+    samplers.push_back(registry.Sample("db_pool_max_connections", "Connections the pool may open", metrics::Type::GAUGE, labels,
+        [this] { return static_cast<double>(configuration.maxPoolSize); }));
+    samplers.push_back(registry.Sample("db_pool_waiters", "Requests waiting for a connection", metrics::Type::GAUGE, labels,
+        [this] { return static_cast<double>(waiters.load(std::memory_order_relaxed)); }));
+}
+
+size_t PostgresConnectionProvider::IdleConnections() {
+    size_t idle = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard lock(shard->mutex);
+        idle += shard->idle.size();
+    }
+    return idle;
+}
+
+bool PostgresConnectionProvider::Ready() const {
+    return warmedConnections.load(std::memory_order_acquire) + requestOpenedConnections.load(std::memory_order_acquire) >= readyConnections;
+}
+
+std::unique_ptr<pqxx::connection> PostgresConnectionProvider::Open() const {
+    // statements are prepared lazily, see PooledConnection::Prepare
+    auto connection = std::make_unique<pqxx::connection>(configuration.connectionString);
+    if (configuration.statementTimeout.count() > 0) {
+        connection->set_session_var("statement_timeout", configuration.statementTimeout.count());
+    }
+    return connection;
+}
+
+size_t PostgresConnectionProvider::HomeShard() const {
+    return threadSlot % shards.size();
+}
+
+PostgresConnection* PostgresConnectionProvider::TryTake(const size_t homeShard, const bool blocking) {
+    {
+        auto& shard = *shards[homeShard];
+        std::lock_guard lock(shard.mutex);
+        if (!shard.idle.empty()) {
+            PostgresConnection* slot = shard.idle.back();
+            shard.idle.pop_back();
+            return slot;
+        }
+    }
+
+    // steal from the other shards, skipping the ones that are busy right now unless the caller would wait otherwise
+    for (size_t i = 1; i < shards.size(); i++) {
+        auto& shard = *shards[(homeShard + i) % shards.size()];
+        std::unique_lock lock(shard.mutex, std::defer_lock);
+        if (blocking) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            continue;
+        }
+        if (!shard.idle.empty()) {
+            PostgresConnection* slot = shard.idle.back();
+            shard.idle.pop_back();
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+PostgresConnection* PostgresConnectionProvider::TryGrow() {
+    PostgresConnection* slot = nullptr;
+    {
+        std::lock_guard lock(spareMutex);
+        if (spare.empty()) {
+            return nullptr;
+        }
+        slot = spare.back();
+        spare.pop_back();
+    }
+    openConnections.fetch_add(1, std::memory_order_relaxed);
+
+    try {
+        slot->connection = Open();
+        slot->prepared.clear();
+        slot->statementTimeout = configuration.statementTimeout;
+    } catch (...) {
+        openConnections.fetch_sub(1, std::memory_order_relaxed);
+        std::lock_guard lock(spareMutex);
+        spare.push_back(slot);
+        throw;
+    }
+    return slot;
+}
+
+PostgresConnection* PostgresConnectionProvider::TryGrowForRequest() {
+    PostgresConnection* slot = TryGrow();
+    if (slot != nullptr) {
+        requestOpenedConnections.fetch_add(1, std::memory_order_acq_rel);
+    }
+    return slot;
+}
+
+void PostgresConnectionProvider::Release(PostgresConnection* slot) noexcept {
+    if (!slot->connection->is_open()) {
+        // broken connections are dropped, the pool grows back lazily
+        slot->connection.reset();
+        openConnections.fetch_sub(1, std::memory_order_relaxed);
+        std::lock_guard lock(spareMutex);
+        spare.push_back(slot);
+    } else {
+        auto& shard = *shards[HomeShard()];
+        std::lock_guard lock(shard.mutex);
+        shard.idle.push_back(slot);
+    }
+
+    if (waiters.load() > 0) {
+        std::lock_guard lock(waitMutex);
+        connectionAvailable.notify_one();
+    }
+}
+
+PooledConnection PostgresConnectionProvider::Connection() {
+    const auto started = std::chrono::steady_clock::now();
+    const size_t homeShard = HomeShard();
+    auto conn = TryTake(homeShard);
+    if (!conn) {
+        conn = TryGrowForRequest();
+    }
+
+    if (!conn) {
+        // the request's own deadline cuts the wait short, a request out of time gives up without waiting
+        const auto requestDeadline = deadline::Current();
+        const auto acquireDeadline = std::chrono::steady_clock::now() + configuration.acquireTimeout;
+        const bool requestBound = requestDeadline < acquireDeadline;
+        const auto waitDeadline = requestBound ? requestDeadline : acquireDeadline;
+        struct WaiterGuard {
+            std::atomic<size_t>& waiters;
+            explicit WaiterGuard(std::atomic<size_t>& waiters) : waiters(waiters) { waiters.fetch_add(1); }
+            ~WaiterGuard() { waiters.fetch_sub(1); }
+        } waiterGuard(waiters);
+
+        std::unique_lock lock(waitMutex);
+        // blocking passes from here on, a shard locked for a moment must not leave its idle connections unseen
+        while (!(conn = TryTake(homeShard, true))) {
+            if (openConnections.load(std::memory_order_relaxed) < configuration.maxPoolSize) {
+                // a broken connection was dropped, open its replacement without blocking releasers
+                lock.unlock();
+                conn = TryGrowForRequest();
+                lock.lock();
+                if (conn) {
+                    break;
+                }
+                continue;
+            }
+            if (connectionAvailable.wait_until(lock, waitDeadline) == std::cv_status::timeout) {
+                if ((conn = TryTake(homeShard, true))) {
+                    break;
+                }
+                acquireTimeouts.Increment();
+                if (requestBound) {
+                    throw DeadlineExceeded("Request deadline passed while waiting for a database connection");
+                }
+                throw ConnectionPoolTimeout(std::format("No database connection available after {}", configuration.acquireTimeout));
+            }
+        }
+    }
+
+    acquireLatency.Observe(metrics::Since(started));
+    return PooledConnection(conn);
+}
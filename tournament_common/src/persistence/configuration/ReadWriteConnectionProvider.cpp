@@ -0,0 +1,92 @@
+#include <print>
+
+#include "persistence/configuration/ReadWriteConnectionProvider.hpp"
+#include "persistence/configuration/PostgresConnectionProvider.hpp"
+
+namespace {
+    config::DatabaseConfiguration ReadPoolDatabaseConfiguration(const config::DatabaseConfiguration& configuration) {
+        config::DatabaseConfiguration readConfiguration = configuration;
+        const auto& readPool = *configuration.readPool;
+        if (!readPool.connectionString.empty()) {
+            readConfiguration.connectionString = readPool.connectionString;
+        }
+        readConfiguration.minPoolSize = readPool.minPoolSize;
+        readConfiguration.maxPoolSize = readPool.maxPoolSize;
+        readConfiguration.readyPoolSize = readPool.minPoolSize;
+        readConfiguration.readPool.reset();
+        return readConfiguration;
+    }
+}
+
+ReadWriteConnectionProvider::ReadWriteConnectionProvider(const config::DatabaseConfiguration& configuration)
+    : writePool(std::make_shared<PostgresConnectionProvider>(configuration)),
+      readPool(std::make_shared<PostgresConnectionProvider>(ReadPoolDatabaseConfiguration(configuration), "read")),
+      configuration(*configuration.readPool),
+      replica(!configuration.readPool->connectionString.empty() && configuration.readPool->connectionString != configuration.connectionString) {
+}
+
+std::shared_ptr<IDbConnectionProvider> ReadWriteConnectionProvider::Create(const config::DatabaseConfiguration& configuration) {
+    if (!configuration.readPool) {
+        return std::make_shared<PostgresConnectionProvider>(configuration);
+    }
+    return std::make_shared<ReadWriteConnectionProvider>(configuration);
+}
+
+bool ReadWriteConnectionProvider::Ready() const {
+    // reads fall back to the primary, so only the write pool gates readiness
+    return writePool->Ready();
+}
+
+PooledConnection ReadWriteConnectionProvider::Connection() {
+    return writePool->Connection();
+}
+
+bool ReadWriteConnectionProvider::ReplicaWithinLag() {
+    try {
+        auto pooled = readPool->Connection();
+        pqxx::read_transaction tx(*pooled);
+        // an idle primary leaves the replay timestamp behind, so only count it while WAL is still being replayed
+        const auto lagMs = tx.query_value<int64_t>(R"(
+            select case when pg_is_in_recovery() and pg_last_wal_receive_lsn() <> pg_last_wal_replay_lsn()
+                        then coalesce(extract(epoch from now() - pg_last_xact_replay_timestamp()) * 1000, 0)
+                        else 0 end::bigint
+        )");
+        tx.commit();
+        if (lagMs > configuration.maxReplicaLag.count()) {
+            std::println("Replica is {}ms behind, reading from primary", lagMs);
+            return false;
+        }
+        return true;
+    } catch (const ConnectionPoolTimeout&) {
+        // a busy replica is still a healthy one
+        return replicaUsable.load(std::memory_order_relaxed);
+    } catch (const DeadlineExceeded&) {
+        // the request carrying the check ran out of time, that says nothing about the replica
+        return replicaUsable.load(std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        std::println("Replica unavailable, reading from primary: {}", e.what());
+        return false;
+    }
+}
+
+PooledConnection ReadWriteConnectionProvider::ReadConnection() {
+    if (!replica) {
+        return readPool->Connection();
+    }
+
+    const int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+    int64_t due = nextLagCheck.load(std::memory_order_relaxed);
+    if (now >= due && nextLagCheck.compare_exchange_strong(due,
+            now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(configuration.lagCheckInterval).count())) {
+        replicaUsable.store(ReplicaWithinLag(), std::memory_order_relaxed);
+    }
+
+    if (replicaUsable.load(std::memory_order_relaxed)) {
+        auto pooled = readPool->Connection();
+        if (pooled->is_open()) {
+            return pooled;
+        }
+        replicaUsable.store(false, std::memory_order_relaxed);
+    }
+    return writePool->Connection();
+}
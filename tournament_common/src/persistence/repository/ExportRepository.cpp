@@ -0,0 +1,54 @@
+#include <format>
+#include <string_view>
+
+#include "persistence/repository/ExportRepository.hpp"
+
+namespace {
+    std::string_view TableName(const ExportSource source) {
+        switch (source) {
+            case ExportSource::TEAMS:
+                return "TEAMS";
+            case ExportSource::TOURNAMENTS:
+                return "TOURNAMENTS";
+            case ExportSource::GROUPS:
+                return "GROUPS";
+        }
+        return "TEAMS";
+    }
+}
+
+ExportRepository::ExportRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider) : connectionProvider(connectionProvider) {}
+
+std::optional<KeysetPosition> ExportRepository::ExportNdjson(const ExportSource source, const PageRequest& request, std::string& output) {
+    auto pooled = connectionProvider->ReadConnection();
+    pqxx::read_transaction tx(*pooled);
+
+    std::string after;
+    if (request.after) {
+        after = std::format("where (created_at, id) > ({}::timestamp, {}::uuid)", tx.quote(request.after->createdAt), tx.quote(request.after->id));
+    }
+    // COPY cannot take bind parameters, the values are quoted into the query instead
+    const std::string query = std::format(R"(
+        select (document || jsonb_build_object('id', id))::text, created_at::text, id::text
+        from {} {}
+        order by created_at, id
+        limit {}
+    )", TableName(source), after, request.limit + 1);
+
+    size_t rows = 0;
+    std::optional<KeysetPosition> last;
+    for (auto [document, createdAt, id] : tx.stream<std::string_view, std::string_view, std::string_view>(query)) {
+        if (++rows > request.limit) {
+            // the extra row only tells that another batch exists
+            continue;
+        }
+        output.append(document);
+        output.push_back('\n');
+        if (rows == request.limit) {
+            last = KeysetPosition{std::string(createdAt), std::string(id)};
+        }
+    }
+    tx.commit();
+
+    return rows > request.limit ? last : std::nullopt;
+}
@@ -2,119 +2,327 @@
 // Created by root on 9/27/25.
 //
 
-#include "domain/Utilities.hpp"
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "domain/JsonSerializer.hpp"
+#include "persistence/configuration/IdTraits.hpp"
 #include  "persistence/repository/GroupRepository.hpp"
+#include "persistence/repository/RowMapper.hpp"
+
+namespace {
+    PreparedStatement& INSERT_GROUP = StatementRegistry::Instance().Declare(
+        "insert_group", "insert into GROUPS (tournament_id, document) values($1, $2) RETURNING id");
+    PreparedStatement& UPDATE_GROUP = StatementRegistry::Instance().Declare(
+        "update_group", "update GROUPS set document = $2, last_update_date = CURRENT_TIMESTAMP where id = $1");
+    PreparedStatement& SELECT_GROUPS_BY_TOURNAMENT = StatementRegistry::Instance().Declare("select_groups_by_tournament",
+        std::format("select {} from {} where g.tournament_id = $1 order by {}",
+            RowMapper<domain::Group>::COLUMNS, RowMapper<domain::Group>::FROM, RowMapper<domain::Group>::ORDER));
+    PreparedStatement& SELECT_GROUP_BY_TOURNAMENTID_GROUPID = StatementRegistry::Instance().Declare("select_group_by_tournamentid_groupid",
+        std::format("select {} from {} where g.tournament_id = $1 and g.id = $2 order by {}",
+            RowMapper<domain::Group>::COLUMNS, RowMapper<domain::Group>::FROM, RowMapper<domain::Group>::ORDER));
+    PreparedStatement& SELECT_GROUPS_BY_IDS = StatementRegistry::Instance().Declare("select_groups_by_ids",
+        std::format("select {} from {} where g.id = ANY($1::uuid[]) order by {}",
+            RowMapper<domain::Group>::COLUMNS, RowMapper<domain::Group>::FROM, RowMapper<domain::Group>::ORDER));
+    PreparedStatement& SELECT_GROUP_VERSION = StatementRegistry::Instance().Declare("select_group_version",
+        std::format("select {} from GROUPS where tournament_id = $1 and id = $2", RowMapper<ResourceVersion>::COLUMNS));
+    PreparedStatement& SELECT_GROUP_IN_TOURNAMENT = StatementRegistry::Instance().Declare("select_group_in_tournament", std::format(R"(
+        select {} from {}
+        where g.id = (select group_id from group_teams where tournament_id = $1 and team_id = $2)
+        order by {}
+    )", RowMapper<domain::Group>::COLUMNS, RowMapper<domain::Group>::FROM, RowMapper<domain::Group>::ORDER));
+    PreparedStatement& SELECT_GROUP_ID_BY_TEAM = StatementRegistry::Instance().Declare(
+        "select_group_id_by_team", "select group_id from group_teams where tournament_id = $1 and team_id = $2");
+    PreparedStatement& COUNT_GROUP_TEAMS = StatementRegistry::Instance().Declare(
+        "count_group_teams", "select count(*) as team_count from group_teams where group_id = $1");
+    // keeps group_teams in sync with the teams appended to the group document, conflicts mean the team is taken
+    PreparedStatement& INSERT_GROUP_TEAMS = StatementRegistry::Instance().Declare("insert_group_teams", R"(
+        insert into group_teams (tournament_id, group_id, team_id)
+        select g.tournament_id, g.id, t.team_id from groups g, unnest($2::uuid[]) t(team_id)
+        where g.id = $1
+        on conflict do nothing
+        returning team_id::text as team_id
+    )");
+    PreparedStatement& DELETE_GROUP_TEAMS_EXCEPT = StatementRegistry::Instance().Declare(
+        "delete_group_teams_except", "delete from group_teams where group_id = $1 and team_id <> ALL($2::uuid[])");
+    // checks and append in one statement. The group row is locked first and the capacity is read from that
+    // locked row, so concurrent appends to the same group queue up behind it and count what the previous one
+    // wrote. A team put in another group concurrently trips the group_teams primary key instead.
+    // Every appended team is announced on queue $4 through the outbox, in the same statement.
+    // One row per requested team comes back, all carrying the same status.
+    PreparedStatement& APPEND_GROUP_TEAMS = StatementRegistry::Instance().Declare("append_group_teams", std::format(R"(
+        with target as (
+            select g.id, g.tournament_id, jsonb_array_length(coalesce(g.document -> 'teams', '[]'::jsonb)) as team_count,
+                   coalesce((t.document -> 'format' ->> 'maxTeamsPerGroup')::int, {}) as capacity
+            from groups g
+            join tournaments t on t.id = g.tournament_id
+            where g.tournament_id = $1 and g.id = $2
+            for update of g
+        ), requested as (
+            select r.team_id, r.position from unnest($3::uuid[]) with ordinality r(team_id, position)
+        ), found as (
+            select te.id, te.document ->> 'name' as name, r.position
+            from requested r join teams te on te.id = r.team_id
+        ), duplicated as (
+            select gt.team_id from group_teams gt where gt.tournament_id = $1 and gt.team_id = ANY($3::uuid[])
+        ), verdict as (
+            select case
+                when not exists (select 1 from target) then 'not_found'
+                when (select team_count from target) + cardinality($3::uuid[]) > (select capacity from target) then 'full'
+                when exists (select 1 from duplicated) then 'duplicated'
+                when (select count(*) from found) < cardinality($3::uuid[]) then 'missing'
+                else 'appended'
+            end as status
+        ), inserted as (
+            insert into group_teams (tournament_id, group_id, team_id)
+            select tg.tournament_id, tg.id, f.id from target tg, found f, verdict v
+            where v.status = 'appended'
+        ), events as (
+            insert into OUTBOX (queue, payload)
+            select $4, jsonb_build_object('tournamentId', tg.tournament_id, 'groupId', tg.id, 'teamId', f.id)::text
+            from target tg, found f, verdict v
+            where v.status = 'appended'
+            order by f.position
+        ), updated as (
+            update groups g
+                set document = jsonb_set(g.document, '{{teams}}', coalesce(g.document -> 'teams', '[]'::jsonb) || coalesce((
+                        select jsonb_agg(jsonb_build_object('id', f.id, 'name', f.name) order by f.position) from found f), '[]'::jsonb)),
+                    last_update_date = CURRENT_TIMESTAMP
+            from verdict v
+            where g.id = $2 and v.status = 'appended'
+        )
+        select v.status, r.team_id, f.name as team_name, d.team_id is not null as duplicated
+        from verdict v
+        left join requested r on true
+        left join found f on f.id = r.team_id
+        left join duplicated d on d.team_id = r.team_id
+        order by r.position
+    )", domain::TournamentFormat().MaxTeamsPerGroup()));
+}
 
-GroupRepository::GroupRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider) : connectionProvider(std::move(connectionProvider)) {}
+GroupRepository::GroupRepository(const std::shared_ptr<IDbConnectionProvider>& connectionProvider, std::shared_ptr<AsyncQueryExecutor> asyncExecutor)
+    : connectionProvider(connectionProvider), asyncExecutor(std::move(asyncExecutor)) {}
 
-std::shared_ptr<domain::Group> GroupRepository::ReadById(std::string id) {
+std::shared_ptr<domain::Group> GroupRepository::ReadById(domain::Id id) {
     return std::make_shared<domain::Group>();
 }
 
-std::string GroupRepository::Create (const domain::Group & entity) {
+domain::Id GroupRepository::Create (const domain::Group & entity) {
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
     nlohmann::json groupBody = entity;
 
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"insert_group"}, pqxx::params{entity.TournamentId(), groupBody.dump()});
+    pqxx::work tx(*pooled);
+    pqxx::result result = Execute(pooled, tx, INSERT_GROUP, pqxx::params{Binary(entity.TournamentId()), groupBody.dump()});
+    const auto id = result[0]["id"].as<domain::Id>();
+    if (!entity.Teams().empty()) {
+        std::vector<domain::Id> teamIds;
+        for (const auto& team : entity.Teams()) {
+            teamIds.push_back(team.Id);
+        }
+        Execute(pooled, tx, INSERT_GROUP_TEAMS, pqxx::params{Binary(id), teamIds});
+    }
 
     tx.commit();
 
-    return result[0]["id"].c_str();
+    return id;
 }
 
-std::string GroupRepository::Update (const domain::Group & entity) {
+domain::Id GroupRepository::Update (const domain::Group & entity) {
     auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
     nlohmann::json groupBody = entity;
 
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"update_group"}, pqxx::params{entity.Id(), groupBody.dump()});
+    pqxx::work tx(*pooled);
+    Execute(pooled, tx, UPDATE_GROUP, pqxx::params{Binary(entity.Id()), groupBody.dump()});
+    std::vector<domain::Id> teamIds;
+    for (const auto& team : entity.Teams()) {
+        teamIds.push_back(team.Id);
+    }
+    Execute(pooled, tx, DELETE_GROUP_TEAMS_EXCEPT, pqxx::params{Binary(entity.Id()), teamIds});
+    Execute(pooled, tx, INSERT_GROUP_TEAMS, pqxx::params{Binary(entity.Id()), teamIds});
 
     tx.commit();
 
     return entity.Id();
 }
 
-void GroupRepository::Delete(std::string id) {
+void GroupRepository::Delete(domain::Id id) {
 
 }
 
 std::vector<std::shared_ptr<domain::Group>> GroupRepository::ReadAll() {
     std::vector<std::shared_ptr<domain::Group>> teams;
 
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    auto pooled = connectionProvider->ReadConnection();
 
-    pqxx::work tx(*(connection->connection));
+    pqxx::read_transaction tx(*pooled);
     pqxx::result result{tx.exec("select id, document->>'name' as name from groups")};
     tx.commit();
 
     for(auto row : result){
-        teams.push_back(std::make_shared<domain::Group>(domain::Group{row["id"].c_str(), row["name"].c_str()}));
+        teams.push_back(std::make_shared<domain::Group>(domain::Group{row["name"].c_str(), row["id"].as<domain::Id>()}));
     }
 
     return teams;
 }
 
-std::vector<std::shared_ptr<domain::Group>> GroupRepository::FindByTournamentId(const std::string_view& tournamentId) {
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+Page<domain::Group> GroupRepository::ReadPage(const PageRequest&) {
+    // groups are only listed per tournament, see FindByTournamentId
+    throw std::logic_error("Groups are not paged");
+}
+
+std::vector<std::shared_ptr<domain::Group>> GroupRepository::FindByTournamentId(const domain::Id& tournamentId) {
+    auto pooled = connectionProvider->ReadConnection();
 
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"select_groups_by_tournament"}, pqxx::params{tournamentId.data()});
+    pqxx::read_transaction tx(*pooled);
+    pqxx::result result = Execute(pooled, tx, SELECT_GROUPS_BY_TOURNAMENT, pqxx::params{Binary(tournamentId)});
     tx.commit();
 
-    std::vector<std::shared_ptr<domain::Group>> groups;
-    for(auto row : result){
-        nlohmann::json groupDocument = nlohmann::json::parse(row["document"].c_str());
-        auto group = std::make_shared<domain::Group>(groupDocument);
-        group->Id() = result[0]["id"].c_str();
+    return MapGroupRows(result);
+}
 
-        groups.push_back(group);
-    }
+void GroupRepository::FindByTournamentIdAsync(const domain::Id& tournamentId, const deadline::Clock::time_point deadline,
+                                              AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion) {
+    SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_GROUPS_BY_TOURNAMENT, {AsyncParam(tournamentId)}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+        return MapGroupRows(rows);
+    });
+}
+
+std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndGroupId(const domain::Id& tournamentId, const domain::Id& groupId) {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    pqxx::result result = Execute(pooled, tx, SELECT_GROUP_BY_TOURNAMENTID_GROUPID, pqxx::params{Binary(tournamentId), Binary(groupId)});
+    tx.commit();
 
-    return groups;
+    auto groups = MapGroupRows(result);
+    return groups.empty() ? nullptr : groups.front();
 }
 
-std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndGroupId(const std::string_view& tournamentId, const std::string_view& groupId) {
-    auto pooled = connectionProvider->Connection();
-    auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+void GroupRepository::FindByTournamentIdAndGroupIdAsync(const domain::Id& tournamentId, const domain::Id& groupId, const deadline::Clock::time_point deadline,
+                                                        AsyncCompletion<std::shared_ptr<domain::Group>> completion) {
+    SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_GROUP_BY_TOURNAMENTID_GROUPID, {AsyncParam(tournamentId), AsyncParam(groupId)}, deadline}, std::move(completion),
+        [](const AsyncRows& rows) {
+            auto groups = MapGroupRows(rows);
+            return groups.empty() ? nullptr : groups.front();
+        });
+}
 
-    pqxx::work tx(*(connection->connection));
-    pqxx::result result = tx.exec(pqxx::prepped{"select_group_by_tournamentid_groupid"}, pqxx::params{tournamentId.data(), groupId.data()});
+std::vector<std::shared_ptr<domain::Group>> GroupRepository::ReadByIds(const std::vector<domain::Id>& ids) {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_GROUPS_BY_IDS, pqxx::params{ids});
     tx.commit();
-    nlohmann::json groupDocument = nlohmann::json::parse(result[0]["document"].c_str());
-    auto group = std::make_shared<domain::Group>(groupDocument);
-    group->Id() = result[0]["id"].c_str();
 
-    return group;
+    return MapGroupRows(result);
 }
 
-std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndTeamId(const std::string_view& tournamentId, const std::string_view& teamId) {
-    auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+std::optional<ResourceVersion> GroupRepository::FindVersion(const domain::Id& tournamentId, const domain::Id& groupId) {
+    auto pooled = connectionProvider->ReadConnection();
 
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"select_group_in_tournament"}, pqxx::params{tournamentId.data(), teamId.data()});
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_GROUP_VERSION, pqxx::params{Binary(tournamentId), Binary(groupId)});
     tx.commit();
+
     if (result.empty()) {
-        return nullptr;
+        return std::nullopt;
     }
-    nlohmann::json groupDocument = nlohmann::json::parse(result[0]["document"].c_str());
-    std::shared_ptr<domain::Group> group = std::make_shared<domain::Group>(groupDocument);
-    group->Id() = result[0]["id"].c_str();
+    ResourceVersion version;
+    RowMapper<ResourceVersion>::Map(result[0], version);
+    return version;
+}
 
-    return group;
+void GroupRepository::FindVersionAsync(const domain::Id& tournamentId, const domain::Id& groupId, const deadline::Clock::time_point deadline,
+                                       AsyncCompletion<std::optional<ResourceVersion>> completion) {
+    SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_GROUP_VERSION, {AsyncParam(tournamentId), AsyncParam(groupId)}, deadline}, std::move(completion),
+        [](const AsyncRows& rows) {
+            std::optional<ResourceVersion> version;
+            if (!rows.empty()) {
+                RowMapper<ResourceVersion>::Map(rows[0], version.emplace());
+            }
+            return version;
+        });
 }
 
-void GroupRepository::UpdateGroupAddTeam(const std::string_view& groupId, const std::shared_ptr<domain::Team> & team) {
-    nlohmann::json teamDocument = team;
+std::shared_ptr<domain::Group> GroupRepository::FindByTournamentIdAndTeamId(const domain::Id& tournamentId, const domain::Id& teamId) {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_GROUP_IN_TOURNAMENT, pqxx::params{Binary(tournamentId), Binary(teamId)});
+    tx.commit();
+
+    auto groups = MapGroupRows(result);
+    return groups.empty() ? nullptr : groups.front();
+}
+
+GroupTeamsUpdate GroupRepository::AddTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Id>& teamIds, const std::string_view eventQueue) {
+    GroupTeamsUpdate update;
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    pqxx::work tx(*pooled);
+
+    pqxx::result result;
+    try {
+        result = Execute(pooled, tx, APPEND_GROUP_TEAMS, pqxx::params{Binary(tournamentId), Binary(groupId), teamIds, eventQueue});
+        tx.commit();
+    } catch (const pqxx::unique_violation&) {
+        // another request put one of the teams in a group after this statement's snapshot was taken
+        update.status = GroupTeamsStatus::DUPLICATED;
+        return update;
+    }
+
+    const std::string_view status = result[0]["status"].view();
+    if (status == "appended") {
+        update.status = GroupTeamsStatus::APPENDED;
+    } else if (status == "full") {
+        update.status = GroupTeamsStatus::GROUP_FULL;
+    } else if (status == "duplicated") {
+        update.status = GroupTeamsStatus::DUPLICATED;
+    } else if (status == "missing") {
+        update.status = GroupTeamsStatus::MISSING_TEAM;
+    } else {
+        return update;
+    }
+
+    for (const auto& row : result) {
+        if (row["team_id"].is_null()) {
+            continue;
+        }
+        const auto teamId = row["team_id"].as<domain::Id>();
+        if (row["duplicated"].as<bool>()) {
+            update.duplicatedTeamIds.push_back(teamId);
+        }
+        if (row["team_name"].is_null()) {
+            update.missingTeamIds.push_back(teamId);
+        } else if (update.status == GroupTeamsStatus::APPENDED) {
+            update.addedTeams.push_back(std::make_shared<domain::Team>(domain::Team{teamId, row["team_name"].c_str()}));
+        }
+    }
+    return update;
+}
 
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"update_group_add_team"}, pqxx::params{groupId.data(), teamDocument.dump()});
+bool GroupRepository::IsTeamInTournament(const domain::Id& tournamentId, const domain::Id& teamId) {
+    return FindGroupIdByTeamId(tournamentId, teamId).has_value();
+}
+
+std::optional<domain::Id> GroupRepository::FindGroupIdByTeamId(const domain::Id& tournamentId, const domain::Id& teamId) {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_GROUP_ID_BY_TEAM, pqxx::params{Binary(tournamentId), Binary(teamId)});
     tx.commit();
-}
\ No newline at end of file
+    if (result.empty()) {
+        return std::nullopt;
+    }
+    return result[0]["group_id"].as<domain::Id>();
+}
+
+size_t GroupRepository::CountTeamsInGroup(const domain::Id& groupId) {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, COUNT_GROUP_TEAMS, pqxx::params{Binary(groupId)});
+    tx.commit();
+
+    return result[0]["team_count"].as<size_t>();
+}
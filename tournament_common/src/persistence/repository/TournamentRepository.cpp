@@ -1,76 +1,199 @@
 //
 // Created by tsuny on 9/1/25.
 //
+#include <algorithm>
+#include <format>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <nlohmann/json.hpp>
 
 #include "persistence/repository/TournamentRepository.hpp"
-#include "domain/Utilities.hpp"
+#include "domain/JsonSerializer.hpp"
+#include "persistence/configuration/IdTraits.hpp"
 #include "persistence/configuration/PostgresConnection.hpp"
+#include "persistence/repository/RowMapper.hpp"
+
+
+namespace {
+    PreparedStatement& INSERT_TOURNAMENT = StatementRegistry::Instance().Declare(
+        "insert_tournament", "insert into TOURNAMENTS (document) values($1) RETURNING id");
+    PreparedStatement& INSERT_TOURNAMENT_WITH_EVENT = StatementRegistry::Instance().Declare("insert_tournament_with_event", R"(
+        with inserted as (
+            insert into TOURNAMENTS (document) values($1) RETURNING id
+        ), event as (
+            insert into OUTBOX (queue, payload) select $2, id::text from inserted
+        )
+        select id from inserted
+    )");
+    PreparedStatement& SELECT_TOURNAMENT_BY_ID = StatementRegistry::Instance().Declare("select_tournament_by_id",
+        std::format("select {} from TOURNAMENTS where id = $1", RowMapper<domain::Tournament>::COLUMNS));
+    PreparedStatement& SELECT_TOURNAMENTS_BY_IDS = StatementRegistry::Instance().Declare("select_tournaments_by_ids",
+        std::format("select {} from TOURNAMENTS where id = ANY($1::uuid[])", RowMapper<domain::Tournament>::COLUMNS));
+    PreparedStatement& SELECT_TOURNAMENTS_PAGE = StatementRegistry::Instance().Declare("select_tournaments_page",
+        std::format("select {}, created_at::text as created_at from TOURNAMENTS order by created_at, id limit $1", RowMapper<domain::Tournament>::COLUMNS));
+    PreparedStatement& SELECT_TOURNAMENTS_PAGE_AFTER = StatementRegistry::Instance().Declare("select_tournaments_page_after", std::format(R"(
+        select {}, created_at::text as created_at from TOURNAMENTS
+        where (created_at, id) > ($1::timestamp, $2::uuid)
+        order by created_at, id limit $3
+    )", RowMapper<domain::Tournament>::COLUMNS));
+    PreparedStatement& SELECT_TOURNAMENT_VERSION = StatementRegistry::Instance().Declare("select_tournament_version",
+        std::format("select {} from TOURNAMENTS where id = $1", RowMapper<ResourceVersion>::COLUMNS));
+    PreparedStatement& SELECT_TOURNAMENTS_VERSION = StatementRegistry::Instance().Declare("select_tournaments_version",
+        std::format("select {} from COLLECTION_VERSIONS where name = 'tournaments'", RowMapper<ResourceVersion>::COLLECTION_COLUMNS));
+    const std::string SELECT_TOURNAMENTS = std::format("select {} from TOURNAMENTS", RowMapper<domain::Tournament>::COLUMNS);
+}
 
-
-TournamentRepository::TournamentRepository(std::shared_ptr<IDbConnectionProvider> connection) : connectionProvider(std::move(connection)) {
+TournamentRepository::TournamentRepository(std::shared_ptr<IDbConnectionProvider> connection, std::shared_ptr<AsyncQueryExecutor> asyncExecutor)
+    : connectionProvider(std::move(connection)), asyncExecutor(std::move(asyncExecutor)) {
 }
 
-std::shared_ptr<domain::Tournament> TournamentRepository::ReadById(std::string id) {
-    auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+std::shared_ptr<domain::Tournament> TournamentRepository::ReadById(const domain::Id id) {
+    auto pooled = connectionProvider->ReadConnection();
 
 
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"select_tournament_by_id"}, id);
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_TOURNAMENT_BY_ID, pqxx::params{Binary(id)});
     tx.commit();
 
     if (result.empty()) {
         return nullptr;
     }
-    nlohmann::json rowTournament = nlohmann::json::parse(result.at(0)["document"].c_str());
-    auto tournament = std::make_shared<domain::Tournament>(rowTournament);
-    tournament->Id() = result.at(0)["id"].c_str();
+    auto tournament = std::make_shared<domain::Tournament>();
+    RowMapper<domain::Tournament>::Map(result[0], *tournament);
 
     return tournament;
 }
 
-std::string TournamentRepository::Create (const domain::Tournament & entity) {
+void TournamentRepository::ReadByIdAsync(const domain::Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Tournament>> completion) {
+    SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_TOURNAMENT_BY_ID, {AsyncParam(id)}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+        std::shared_ptr<domain::Tournament> tournament;
+        if (!rows.empty()) {
+            tournament = std::make_shared<domain::Tournament>();
+            RowMapper<domain::Tournament>::Map(rows[0], *tournament);
+        }
+        return tournament;
+    });
+}
+
+domain::Id TournamentRepository::Create (const domain::Tournament & entity) {
 
     const nlohmann::json tournamentDoc = entity;
 
     auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result = tx.exec(pqxx::prepped{"insert_tournament"}, tournamentDoc.dump());
+    pqxx::work tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, INSERT_TOURNAMENT, pqxx::params{tournamentDoc.dump()});
+
+    tx.commit();
+
+    return result[0]["id"].as<domain::Id>();
+}
+
+domain::Id TournamentRepository::CreateWithEvent(const domain::Tournament& entity, const std::string_view queue) {
+    const nlohmann::json tournamentDoc = entity;
+    auto pooled = connectionProvider->Connection();
+
+    pqxx::work tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, INSERT_TOURNAMENT_WITH_EVENT, pqxx::params{tournamentDoc.dump(), queue});
+    tx.commit();
+
+    return result[0]["id"].as<domain::Id>();
+}
+
+domain::Id TournamentRepository::Update (const domain::Tournament & entity) {
+    return entity.Id();
+}
+
+void TournamentRepository::Delete(domain::Id id) {
+
+}
+
+std::optional<ResourceVersion> TournamentRepository::ReadVersion(const domain::Id& id) {
+    auto pooled = connectionProvider->ReadConnection();
 
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_TOURNAMENT_VERSION, pqxx::params{Binary(id)});
     tx.commit();
 
-    return result[0]["id"].c_str();
+    if (result.empty()) {
+        return std::nullopt;
+    }
+    ResourceVersion version;
+    RowMapper<ResourceVersion>::Map(result[0], version);
+    return version;
 }
 
-std::string TournamentRepository::Update (const domain::Tournament & entity) {
-    return "id";
+void TournamentRepository::ReadVersionAsync(const domain::Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) {
+    SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_TOURNAMENT_VERSION, {AsyncParam(id)}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+        std::optional<ResourceVersion> version;
+        if (!rows.empty()) {
+            RowMapper<ResourceVersion>::Map(rows[0], version.emplace());
+        }
+        return version;
+    });
 }
 
-void TournamentRepository::Delete(std::string id) {
+ResourceVersion TournamentRepository::ReadCollectionVersion() {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_TOURNAMENTS_VERSION, pqxx::params{});
+    tx.commit();
+
+    ResourceVersion version;
+    RowMapper<ResourceVersion>::Map(result[0], version);
+    return version;
+}
 
+void TournamentRepository::ReadCollectionVersionAsync(const deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) {
+    SubmitMapped(asyncExecutor, AsyncQuery{&SELECT_TOURNAMENTS_VERSION, {}, deadline}, std::move(completion), [](const AsyncRows& rows) {
+        if (rows.empty()) {
+            throw std::runtime_error("COLLECTION_VERSIONS has no tournaments row");
+        }
+        ResourceVersion version;
+        RowMapper<ResourceVersion>::Map(rows[0], version);
+        return version;
+    });
 }
 
 std::vector<std::shared_ptr<domain::Tournament>> TournamentRepository::ReadAll() {
-    std::vector<std::shared_ptr<domain::Tournament>> tournaments;
+    auto pooled = connectionProvider->ReadConnection();
 
-    auto pooled = connectionProvider->Connection();
-    const auto connection = dynamic_cast<PostgresConnection*>(&*pooled);
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result{tx.exec(SELECT_TOURNAMENTS)};
+    tx.commit();
 
-    pqxx::work tx(*(connection->connection));
-    const pqxx::result result{tx.exec("select id, document from tournaments")};
+    return MapRows<domain::Tournament>(result);
+}
+
+std::vector<std::shared_ptr<domain::Tournament>> TournamentRepository::ReadByIds(const std::vector<domain::Id>& ids) {
+    auto pooled = connectionProvider->ReadConnection();
+
+    pqxx::read_transaction tx(*pooled);
+    const pqxx::result result = Execute(pooled, tx, SELECT_TOURNAMENTS_BY_IDS, pqxx::params{ids});
     tx.commit();
 
-    for(auto row : result){
-        nlohmann::json rowTournament = nlohmann::json::parse(row["document"].c_str());
-        auto tournament = std::make_shared<domain::Tournament>(rowTournament);
-        tournament->Id() = row["id"].c_str();
+    return MapRows<domain::Tournament>(result);
+}
 
-        tournaments.push_back(tournament);
-    }
+Page<domain::Tournament> TournamentRepository::ReadPage(const PageRequest& request) {
+    auto pooled = connectionProvider->ReadConnection();
 
-    return tournaments;
-}
\ No newline at end of file
+    pqxx::read_transaction tx(*pooled);
+    // one extra row tells whether there is a next page
+    const pqxx::result result = request.after
+        ? Execute(pooled, tx, SELECT_TOURNAMENTS_PAGE_AFTER, pqxx::params{request.after->createdAt, request.after->id, request.limit + 1})
+        : Execute(pooled, tx, SELECT_TOURNAMENTS_PAGE, pqxx::params{request.limit + 1});
+    tx.commit();
+
+    return MapPage<domain::Tournament>(result, request.limit);
+}
+
+void TournamentRepository::ReadPageAsync(const PageRequest& request, const deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Tournament>> completion) {
+    AsyncQuery query = request.after
+        ? AsyncQuery{&SELECT_TOURNAMENTS_PAGE_AFTER, {request.after->createdAt, request.after->id, std::to_string(request.limit + 1)}, deadline}
+        : AsyncQuery{&SELECT_TOURNAMENTS_PAGE, {std::to_string(request.limit + 1)}, deadline};
+    SubmitMapped(asyncExecutor, std::move(query), std::move(completion), [limit = request.limit](const AsyncRows& rows) {
+        return MapPage<domain::Tournament>(rows, limit);
+    });
+}
@@ -7,6 +7,7 @@
 
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <thread>
 #include <cms/MessageConsumer.h>
@@ -14,6 +15,7 @@
 #include <print>
 
 #include "cms/ConnectionManager.hpp"
+#include "metrics/Metrics.hpp"
 
 class QueueMessageListener {
     std::shared_ptr<ConnectionManager> connectionManager;
@@ -42,12 +44,24 @@ inline void QueueMessageListener::Start(const std::string_view& queueName) {
         session = connectionManager->CreateSession();
         const auto destination = std::unique_ptr<cms::Queue>(session->createQueue(queueName.data()));
         auto consumer = std::unique_ptr<cms::MessageConsumer>(session->createConsumer(destination.get()));
+        const metrics::Labels labels{{"queue", std::string(queueName)}};
+        auto& processingLatency = metrics::Registry::Instance().GetHistogram(
+            "consumer_processing_seconds", "Time a listener took to process one message", labels);
+        auto& processingErrors = metrics::Registry::Instance().GetCounter(
+            "consumer_processing_errors_total", "Messages whose processing raised an error", labels);
 
         while (running) {
             std::unique_ptr<cms::Message> message(consumer->receive(1500));
             if (message) {
                 if (auto text = dynamic_cast<cms::TextMessage*>(message.get())) {
-                   processMessage(text->getText());
+                    const auto started = std::chrono::steady_clock::now();
+                    try {
+                        processMessage(text->getText());
+                    } catch (...) {
+                        processingErrors.Increment();
+                        throw;
+                    }
+                    processingLatency.Observe(metrics::Since(started));
                 }
             }
         }
@@ -11,11 +11,13 @@
 #include <memory>
 
 #include "configuration/DatabaseConfiguration.hpp"
+#include "configuration/MetricsConfiguration.hpp"
 #include "cms/ConnectionManager.hpp"
 #include "persistence/repository/IRepository.hpp"
 #include "persistence/repository/TeamRepository.hpp"
-#include "persistence/configuration/PostgresConnectionProvider.hpp"
+#include "persistence/configuration/ReadWriteConnectionProvider.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
+#include "persistence/repository/GroupRepository.hpp"
 #include "cms/GroupAddTeamListener.hpp"
 #include "delegate/MatchDelegate.hpp"
 #include "persistence/repository/IMatchRepository.hpp"
@@ -29,8 +31,11 @@ namespace config {
         nlohmann::json configuration;
         file >> configuration;
 
-        std::shared_ptr<PostgresConnectionProvider> postgressConnection = std::make_shared<PostgresConnectionProvider>(configuration["databaseConfig"]["connectionString"].get<std::string>(), configuration["databaseConfig"]["poolSize"].get<size_t>());
+        const auto databaseConfiguration = configuration["databaseConfig"].get<DatabaseConfiguration>();
+        std::shared_ptr<IDbConnectionProvider> postgressConnection = ReadWriteConnectionProvider::Create(databaseConfiguration);
         builder.registerInstance(postgressConnection).as<IDbConnectionProvider>();
+        builder.registerInstance(std::make_shared<MetricsConfiguration>(
+            configuration.contains("metricsConfig") ? configuration["metricsConfig"].get<MetricsConfiguration>() : MetricsConfiguration{}));
 
         builder.registerType<ConnectionManager>()
             .onActivated([configuration](Hypodermic::ComponentContext& context, const std::shared_ptr<ConnectionManager>& instance) {
@@ -40,8 +45,21 @@ namespace config {
 
         builder.registerType<GroupAddTeamListener>();
 
-        builder.registerType<TeamRepository>().as<IRepository<domain::Team, std::string_view>>().singleInstance();
-        builder.registerType<TournamentRepository>().as<IRepository<domain::Tournament, std::string>>().singleInstance();
+        // the consumer only runs blocking queries, its repositories get no async executor
+        builder.registerInstanceFactory([](Hypodermic::ComponentContext& context) {
+                return std::make_shared<TeamRepository>(context.resolve<IDbConnectionProvider>(), nullptr);
+            })
+            .as<IRepository<domain::Team, domain::Id>>()
+            .singleInstance();
+        builder.registerInstanceFactory([](Hypodermic::ComponentContext& context) {
+                return std::make_shared<TournamentRepository>(context.resolve<IDbConnectionProvider>(), nullptr);
+            })
+            .as<IRepository<domain::Tournament, domain::Id>>()
+            .singleInstance();
+        builder.registerInstanceFactory([](Hypodermic::ComponentContext& context) {
+                return std::make_shared<GroupRepository>(context.resolve<IDbConnectionProvider>(), nullptr);
+            })
+            .singleInstance();
         builder.registerType<MatchRepository>().as<IMatchRepository>().singleInstance();
 
         builder.registerType<MatchDelegate>().singleInstance();
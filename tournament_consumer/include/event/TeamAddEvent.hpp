@@ -4,14 +4,16 @@
 
 #ifndef TOURNAMENTS_GROUPADDEVENT_HPP
 #define TOURNAMENTS_GROUPADDEVENT_HPP
-#include <string>
 #include <nlohmann/json.hpp>
 
+#include "domain/Id.hpp"
+#include "domain/Utilities.hpp"
+
 namespace domain {
     struct TeamAddEvent {
-        std::string tournamentId;
-        std::string groupId;
-        std::string teamId;
+        Id tournamentId;
+        Id groupId;
+        Id teamId;
     };
 
     inline void from_json(const nlohmann::json &json, TeamAddEvent &teamAddEvent) {
@@ -2,16 +2,34 @@
 // Created by tomas on 9/6/25.
 //
 #include <activemq/library/ActiveMQCPP.h>
+#include <crow.h>
+#include <future>
+#include <string>
 #include <thread>
 
 #include "configuration/ContainerSetup.hpp"
+#include "configuration/StartupReport.hpp"
+#include "metrics/Metrics.hpp"
 
 int main() {
+    auto& startup = config::StartupReport::Instance();
     activemq::library::ActiveMQCPP::initializeLibrary();
     {
-        std::println("before container");
         const auto container = config::containerSetup();
-        std::println("after container");
+        startup.Mark("container built");
+
+        // the consumer serves no other HTTP, Prometheus scrapes it on its own port
+        const auto metricsConfiguration = container->resolve<config::MetricsConfiguration>();
+        crow::SimpleApp metricsApp;
+        CROW_ROUTE(metricsApp, "/metrics")([] {
+            crow::response response{crow::OK, metrics::Registry::Instance().Render()};
+            response.add_header("content-type", std::string(metrics::CONTENT_TYPE));
+            return response;
+        });
+        std::future<void> metricsServer;
+        if (metricsConfiguration->enabled) {
+            metricsServer = metricsApp.port(metricsConfiguration->port).concurrency(1).run_async();
+        }
 
         std::thread tournamentCreatedThread([&] {
             auto listener = container->resolve<GroupAddTeamListener>();
@@ -20,6 +38,7 @@ int main() {
         //crear otro thread aqui
 
         tournamentCreatedThread.join();
+        metricsApp.stop();
         //join de otro thread aqui
         // while (true) {
         //     std::this_thread::sleep_for(std::chrono::seconds(5));
@@ -0,0 +1,81 @@
+// Parsing cost of representative write bodies, nlohmann::json as the controllers used it (accept,
+// then parse into a DOM and convert) against the single pass simdjson readers in RequestBody.hpp.
+// Run: request_body_benchmark [iterations]
+
+#include <chrono>
+#include <print>
+#include <string>
+#include <nlohmann/json.hpp>
+
+#include "controller/RequestBody.hpp"
+#include "domain/Utilities.hpp"
+
+namespace {
+    template<typename Parse>
+    double NanosPerBody(const int iterations, Parse&& parse) {
+        size_t sink = 0;
+        const auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            sink += parse();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - started;
+        if (sink == 0) {
+            std::println("nothing parsed");
+        }
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+    }
+
+    void Report(const std::string_view name, const std::string& body, const double dom, const double onDemand) {
+        std::println("{:<16} {:>6} bytes  nlohmann {:>9.1f} ns  simdjson {:>9.1f} ns  x{:.2f}", name, body.size(), dom, onDemand, dom / onDemand);
+    }
+
+    std::string TeamArray(const int size) {
+        nlohmann::json teams = nlohmann::json::array();
+        for (int i = 0; i < size; i++) {
+            teams.push_back({{"id", std::format("3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b{:04d}", i)}, {"name", std::format("Team number {}", i)}});
+        }
+        return teams.dump();
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 200000;
+
+    const std::string team = R"({"name": "Club Atletico de Prueba"})";
+    const std::string tournament = R"({"name": "Copa de Invierno", "format": {"numberOfGroups": 8, "maxTeamsPerGroup": 4, "type": "ROUND_ROBIN"}})";
+    const std::string teams = TeamArray(31);
+    const std::string group = std::format(R"({{"name": "Group A", "teams": {}}})", TeamArray(4));
+
+    Report("team", team,
+        NanosPerBody(iterations, [&] {
+            if (!nlohmann::json::accept(team)) {
+                return size_t{0};
+            }
+            const domain::Team parsed = nlohmann::json::parse(team);
+            return parsed.Name.size();
+        }),
+        NanosPerBody(iterations, [&] { return request_body::ParseTeam(team)->Name.size(); }));
+
+    Report("tournament", tournament,
+        NanosPerBody(iterations, [&] {
+            const domain::Tournament parsed = nlohmann::json::parse(tournament);
+            return parsed.Name().size();
+        }),
+        NanosPerBody(iterations, [&] { return request_body::ParseTournament(tournament)->Name().size(); }));
+
+    Report("group", group,
+        NanosPerBody(iterations, [&] {
+            const domain::Group parsed = nlohmann::json::parse(group);
+            return parsed.Teams().size();
+        }),
+        NanosPerBody(iterations, [&] { return request_body::ParseGroup(group)->Teams().size(); }));
+
+    Report("31 teams", teams,
+        NanosPerBody(iterations, [&] {
+            const std::vector<domain::Team> parsed = nlohmann::json::parse(teams);
+            return parsed.size();
+        }),
+        NanosPerBody(iterations, [&] { return request_body::ParseTeams(teams)->size(); }));
+
+    return 0;
+}
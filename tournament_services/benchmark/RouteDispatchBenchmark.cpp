@@ -0,0 +1,59 @@
+// Per request cost of getting from a matched route to the controller method, resolving the
+// controller from the container on every call (the old REGISTER_ROUTE) against the instance
+// captured when the route is bound. Run: route_dispatch_benchmark [iterations]
+
+#include <chrono>
+#include <print>
+#include <string>
+#include <Hypodermic/Hypodermic.h>
+#include <crow.h>
+
+#include "configuration/RouteDefinition.hpp"
+
+namespace {
+    class EchoController {
+    public:
+        crow::response GetEcho(const std::string& id) {
+            return crow::response{crow::OK, id};
+        }
+    };
+
+    template<typename Dispatch>
+    double NanosPerCall(const int iterations, Dispatch&& dispatch) {
+        size_t sink = 0;
+        const auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            sink += dispatch().body.size();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - started;
+        if (sink == 0) {
+            std::println("nothing dispatched");
+        }
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 1000000;
+
+    Hypodermic::ContainerBuilder builder;
+    builder.registerType<EchoController>().singleInstance();
+    const auto container = builder.build();
+
+    crow::request request;
+    std::string id = "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10";
+
+    const double perRequest = NanosPerCall(iterations, [&] {
+        auto controller = container->resolve<EchoController>();
+        return invokeController(controller.get(), &EchoController::GetEcho, request, id);
+    });
+    const auto captured = container->resolve<EchoController>();
+    const double bound = NanosPerCall(iterations, [&] {
+        return invokeController(captured.get(), &EchoController::GetEcho, request, id);
+    });
+
+    std::println("{} iterations", iterations);
+    std::println("resolve per request {:>8.1f} ns/call", perRequest);
+    std::println("resolved at bind    {:>8.1f} ns/call", bound);
+    return 0;
+}
@@ -5,14 +5,18 @@
 #ifndef SERVICE_MESSAGE_PRODUCER_HPP
 #define SERVICE_MESSAGE_PRODUCER_HPP
 
+#include <chrono>
 #include <string_view>
 #include <memory>
 
 #include "IQueueMessageProducer.hpp"
 #include "cms/ConnectionManager.hpp"
+#include "metrics/Metrics.hpp"
 
 class QueueMessageProducer: public IQueueMessageProducer {
     std::shared_ptr<ConnectionManager> connectionManager;
+    metrics::Histogram& sendLatency = metrics::Registry::Instance().GetHistogram(
+        "broker_send_seconds", "Time the broker took to accept a persistent message", {{"sender", "producer"}});
 public:
     explicit QueueMessageProducer(const std::shared_ptr<ConnectionManager>& connectionManager) : connectionManager(connectionManager){}
 
@@ -23,7 +27,9 @@ public:
         producer->setDeliveryMode( cms::DeliveryMode::PERSISTENT);
 
         const auto brokerMessage = std::unique_ptr<cms::TextMessage>(session->createTextMessage(message.data()));
+        const auto started = std::chrono::steady_clock::now();
         producer->send(brokerMessage.get());
+        sendLatency.Observe(metrics::Since(started));
     }
 };
 
@@ -13,13 +13,15 @@
 #include "persistence/repository/IRepository.hpp"
 #include "persistence/repository/TeamRepository.hpp"
 #include "RunConfiguration.hpp"
+#include "configuration/DatabaseConfiguration.hpp"
 #include "cms/ConnectionManager.hpp"
 #include "delegate/TeamDelegate.hpp"
 #include "controller/HealthController.hpp"
 #include "controller/TeamController.hpp"
 #include "controller/TournamentController.hpp"
 #include "delegate/TournamentDelegate.hpp"
-#include "persistence/configuration/PostgresConnectionProvider.hpp"
+#include "persistence/configuration/ReadWriteConnectionProvider.hpp"
+#include "persistence/configuration/AsyncQueryExecutor.hpp"
 #include "persistence/repository/TournamentRepository.hpp"
 #include "persistence/repository/GroupRepository.hpp"
 #include "cms/QueueMessageProducer.hpp"
@@ -27,6 +29,23 @@
 #include "delegate/IGroupDelegate.hpp"
 #include "delegate/GroupDelegate.hpp"
 #include "controller/GroupController.hpp"
+#include "controller/CacheController.hpp"
+#include "controller/StatementController.hpp"
+#include "controller/OutboxController.hpp"
+#include "cms/OutboxRelay.hpp"
+#include "configuration/OutboxConfiguration.hpp"
+#include "controller/ExportController.hpp"
+#include "persistence/repository/ExportRepository.hpp"
+#include "configuration/CacheConfiguration.hpp"
+#include "configuration/AdmissionConfiguration.hpp"
+#include "controller/AdmissionController.hpp"
+#include "configuration/CompressionConfiguration.hpp"
+#include "controller/CompressionController.hpp"
+#include "controller/MetricsController.hpp"
+#include "cms/CacheInvalidationBus.hpp"
+#include "persistence/repository/CachedRepository.hpp"
+#include "configuration/CoalescingConfiguration.hpp"
+#include "controller/CoalescingController.hpp"
 
 namespace config {
     inline std::shared_ptr<Hypodermic::Container> containerSetup() {
@@ -37,11 +56,18 @@ namespace config {
         file >> configuration;
         std::shared_ptr<RunConfiguration> appConfig = std::make_shared<RunConfiguration>(configuration["runConfig"]);
         builder.registerInstance(appConfig);
+        const auto admissionConfiguration = configuration.contains("admissionConfig")
+            ? configuration["admissionConfig"].get<AdmissionConfiguration>() : AdmissionConfiguration{};
+        builder.registerInstance(std::make_shared<AdmissionConfiguration>(admissionConfiguration));
+        builder.registerInstance(std::make_shared<admission::ConcurrencyLimiter>(admissionConfiguration));
+        builder.registerInstance(std::make_shared<CompressionConfiguration>(
+            configuration.contains("compressionConfig") ? configuration["compressionConfig"].get<CompressionConfiguration>() : CompressionConfiguration{}));
+        builder.registerInstance(std::make_shared<compression::CompressionStats>());
 
-        std::shared_ptr<PostgresConnectionProvider> postgressConnection = std::make_shared<PostgresConnectionProvider>(
-            configuration["databaseConfig"]["connectionString"].get<std::string>(),
-            configuration["databaseConfig"]["poolSize"].get<size_t>());
+        const auto databaseConfiguration = configuration["databaseConfig"].get<DatabaseConfiguration>();
+        std::shared_ptr<IDbConnectionProvider> postgressConnection = ReadWriteConnectionProvider::Create(databaseConfiguration);
         builder.registerInstance(postgressConnection).as<IDbConnectionProvider>();
+        builder.registerInstance(std::make_shared<AsyncQueryExecutor>(databaseConfiguration));
 
         builder.registerType<ConnectionManager>()
             .onActivated([configuration](Hypodermic::ComponentContext&, const std::shared_ptr<ConnectionManager>& instance) {
@@ -53,27 +79,98 @@ namespace config {
         builder.registerType<QueueResolver>().as<IResolver<IQueueMessageProducer> >().named("queueResolver").
                 singleInstance();
 
-        builder.registerType<TeamRepository>().as<IRepository<domain::Team, std::string_view> >().singleInstance();
-        builder.registerType<GroupRepository>().as<IGroupRepository>().singleInstance();
+        builder.registerType<CacheInvalidationBus>().singleInstance();
+        const auto coalescingConfiguration = configuration.contains("coalescingConfig")
+            ? configuration["coalescingConfig"].get<CoalescingConfiguration>() : CoalescingConfiguration{};
+
+        builder.registerType<TeamRepository>()
+            .as<IBulkRepository<domain::Team> >()
+            .as<IVersionRepository<domain::Team> >()
+            .as<IAsyncVersionRepository<domain::Team> >()
+            .asSelf()
+            .singleInstance();
+        builder.registerInstanceFactory([coalescingConfiguration](Hypodermic::ComponentContext& context) {
+                const auto repository = context.resolve<TeamRepository>();
+                return std::make_shared<CoalescingTeamRepository>(repository, repository, coalescingConfiguration);
+            })
+            .singleInstance();
+        builder.registerInstanceFactory([configuration](Hypodermic::ComponentContext& context) {
+                return std::make_shared<CachedTeamRepository>(
+                    context.resolve<CoalescingTeamRepository>(),
+                    context.resolve<TeamRepository>(),
+                    context.resolve<CacheInvalidationBus>(),
+                    "teams",
+                    configuration["cacheConfig"]["teams"].get<CacheConfiguration>());
+            })
+            .as<IRepository<domain::Team, domain::Id> >()
+            .as<IAsyncRepository<domain::Team, domain::Id> >()
+            .asSelf()
+            .singleInstance();
+        builder.registerType<GroupRepository>()
+            .as<IAsyncGroupRepository>()
+            .asSelf()
+            .singleInstance();
+        builder.registerInstanceFactory([coalescingConfiguration](Hypodermic::ComponentContext& context) {
+                const auto repository = context.resolve<GroupRepository>();
+                return std::make_shared<CoalescingGroupRepository>(repository, repository, coalescingConfiguration);
+            })
+            .as<IGroupRepository>()
+            .asSelf()
+            .singleInstance();
 
         builder.registerType<TeamDelegate>().as<ITeamDelegate>().singleInstance();
         builder.registerType<TeamController>().singleInstance();
 
-        builder.registerType<TournamentRepository>().as<IRepository<domain::Tournament, std::string> >().
-                singleInstance();
+        builder.registerType<TournamentRepository>()
+            .as<IOutboxRepository<domain::Tournament> >()
+            .as<IVersionRepository<domain::Tournament> >()
+            .as<IAsyncVersionRepository<domain::Tournament> >()
+            .asSelf()
+            .singleInstance();
+        builder.registerInstanceFactory([coalescingConfiguration](Hypodermic::ComponentContext& context) {
+                const auto repository = context.resolve<TournamentRepository>();
+                return std::make_shared<CoalescingTournamentRepository>(repository, repository, coalescingConfiguration);
+            })
+            .singleInstance();
+        builder.registerInstanceFactory([configuration](Hypodermic::ComponentContext& context) {
+                return std::make_shared<CachedTournamentRepository>(
+                    context.resolve<CoalescingTournamentRepository>(),
+                    context.resolve<TournamentRepository>(),
+                    context.resolve<CacheInvalidationBus>(),
+                    "tournaments",
+                    configuration["cacheConfig"]["tournaments"].get<CacheConfiguration>());
+            })
+            .as<IRepository<domain::Tournament, domain::Id> >()
+            .as<IAsyncRepository<domain::Tournament, domain::Id> >()
+            .asSelf()
+            .singleInstance();
 
         builder.registerType<TournamentDelegate>()
                 .as<ITournamentDelegate>()
                 .singleInstance();
         builder.registerType<TournamentController>().singleInstance();
 
-        builder.registerType<GroupDelegate>().as<IGroupDelegate>()
-            .with<IQueueMessageProducer>([](Hypodermic::ComponentContext& context){
-                return context.resolveNamed<QueueMessageProducer>("tournamentAddTeamQueue");
-            })
-            .singleInstance();
+        builder.registerType<GroupDelegate>().as<IGroupDelegate>().singleInstance();
         builder.registerType<GroupController>().singleInstance();
         builder.registerType<HealthController>().singleInstance();
+        builder.registerType<CacheController>().singleInstance();
+        builder.registerType<StatementController>().singleInstance();
+        builder.registerType<CompressionController>().singleInstance();
+        builder.registerType<CoalescingController>().singleInstance();
+        builder.registerType<AdmissionController>().singleInstance();
+        builder.registerType<MetricsController>().singleInstance();
+
+        builder.registerInstanceFactory([configuration](Hypodermic::ComponentContext& context) {
+                return std::make_shared<OutboxRelay>(
+                    context.resolve<IDbConnectionProvider>(),
+                    context.resolve<ConnectionManager>(),
+                    configuration.contains("outboxConfig") ? configuration["outboxConfig"].get<OutboxConfiguration>() : OutboxConfiguration{});
+            })
+            .singleInstance();
+        builder.registerType<OutboxController>().singleInstance();
+
+        builder.registerType<ExportRepository>().as<IExportRepository>().singleInstance();
+        builder.registerType<ExportController>().singleInstance();
 
         return builder.build();
     }
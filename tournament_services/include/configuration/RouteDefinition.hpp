@@ -7,15 +7,29 @@
 
 #include <crow.h>
 #include <Hypodermic/Container.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <functional>
 #include <string>
 
+#include "controller/AsyncReply.hpp"
+#include "middleware/AdmissionMiddleware.hpp"
+#include "middleware/CompressionMiddleware.hpp"
+#include "metrics/Metrics.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+
+// admission runs first so shed requests skip everything else, compression sees the final body
+using TournamentApp = crow::App<AdmissionMiddleware, CompressionMiddleware>;
+
 // Route definition storage
 struct RouteDefinition {
     std::string path;
     crow::HTTPMethod method;
-    std::function<void(crow::SimpleApp &, std::shared_ptr<Hypodermic::Container>)> binder;
+    std::function<void(TournamentApp &, std::shared_ptr<Hypodermic::Container>)> binder;
 };
 
 inline std::vector<RouteDefinition> &routeRegistry() {
@@ -23,6 +37,9 @@ inline std::vector<RouteDefinition> &routeRegistry() {
     return registry;
 }
 
+template<typename>
+inline constexpr bool unsupportedControllerMethod = false;
+
 template<typename Controller, typename Method, typename... Args>
 auto invokeController(Controller* controller, Method method, const crow::request& request, Args&&... args) {
     if constexpr(std::is_invocable_v<Method, Controller*>) {
@@ -34,25 +51,178 @@ auto invokeController(Controller* controller, Method method, const crow::request
     else if constexpr( std::is_invocable_v<Method, Controller*, const crow::request&>) {
         return (controller->*method)(request);
     }
-    if constexpr(std::is_invocable_v<Method, Controller*, const crow::request&, Args...>) {
+    else if constexpr(std::is_invocable_v<Method, Controller*, const crow::request&, Args...>) {
         return (controller->*method)(request, std::forward<Args>(args)...);
     }
     else  {
-        throw std::runtime_error("Controller does not exist");
+        static_assert(unsupportedControllerMethod<Method>,
+            "controller methods take (), (route args...), (const crow::request&) or (const crow::request&, route args...)");
+    }
+}
+
+// Latency and responses by status class of one route, looked up once when it is bound. A handler that
+// throws is counted as the 500 Crow answers with.
+class RouteMetrics {
+    metrics::Histogram& latency;
+    std::array<metrics::Counter*, 5> responses{};
+public:
+    RouteMetrics(const std::string& path, const crow::HTTPMethod method)
+        : latency(metrics::Registry::Instance().GetHistogram("http_request_duration_seconds", "Time spent in the route handler",
+                                                             {{"route", path}, {"method", crow::method_name(method)}})) {
+        for (size_t i = 0; i < responses.size(); i++) {
+            responses[i] = &metrics::Registry::Instance().GetCounter("http_responses_total", "Responses by route and status class",
+                {{"route", path}, {"method", crow::method_name(method)}, {"code", std::to_string(i + 1) + "xx"}});
+        }
     }
 
+    void Record(const int code, const std::chrono::nanoseconds elapsed) {
+        latency.Observe(elapsed);
+        responses[std::clamp(code / 100, 1, 5) - 1]->Increment();
+    }
+};
+
+// Timeouts waiting on the database turn into 503 so the client backs off instead of retrying at once. retryAfter
+// is the admission configuration's, so these agree with the 503s AdmissionMiddleware sends, and failure is the
+// request's admission context, whose after_handle tells the limiter.
+template<typename Controller, typename Method, typename... Args>
+crow::response handleRoute(Controller* controller, Method method, const std::string& retryAfter, admission::Failure& failure,
+                           const crow::request& request, Args&&... args) {
+    try {
+        return invokeController(controller, method, request, std::forward<Args>(args)...);
+    } catch (const ConnectionPoolTimeout&) {
+        failure = admission::Failure::POOL_TIMEOUT;
+        crow::response busy{crow::SERVICE_UNAVAILABLE};
+        busy.add_header(RETRY_AFTER_HEADER, retryAfter);
+        return busy;
+    } catch (const DeadlineExceeded&) {
+        failure = admission::Failure::DEADLINE_EXCEEDED;
+        crow::response late{crow::SERVICE_UNAVAILABLE};
+        late.add_header(RETRY_AFTER_HEADER, retryAfter);
+        return late;
+    }
 }
 
-// Annotation-style macro
+// Annotation-style macro. Controllers are resolved once when the route is bound and the handler
+// keeps the instance, so they must be registered as single instances.
 #define REGISTER_ROUTE(Controller, Method, Path, HttpMethod) \
 struct Controller## _##Method##_RouteRegistrator { \
     Controller##_##Method##_RouteRegistrator() { \
         routeRegistry().push_back({ Path, HttpMethod, \
-            [](crow::SimpleApp& app, const std::shared_ptr<Hypodermic::Container>& container) { \
+            [](TournamentApp& app, const std::shared_ptr<Hypodermic::Container>& container) { \
+                    CROW_ROUTE(app, Path).methods(HttpMethod)( \
+                        [&app, controller = container->resolve<Controller>(), routeMetrics = std::make_shared<RouteMetrics>(Path, HttpMethod), \
+                         retryAfter = std::to_string(container->resolve<config::AdmissionConfiguration>()->retryAfter.count())] \
+                        (const crow::request& request ,auto&&... args) -> crow::response { \
+                        const auto started = std::chrono::steady_clock::now(); \
+                        try { \
+                            crow::response response = handleRoute(controller.get(), &Controller::Method, retryAfter, \
+                                app.get_context<AdmissionMiddleware>(request).failure, request, std::forward<decltype(args)>(args)...); \
+                            routeMetrics->Record(response.code, metrics::Since(started)); \
+                            return response; \
+                        } catch (...) { \
+                            routeMetrics->Record(crow::INTERNAL_SERVER_ERROR, metrics::Since(started)); \
+                            throw; \
+                        } \
+                    } \
+                ); \
+            } \
+        }); \
+    } \
+}; \
+static Controller##_##Method##_RouteRegistrator global_##Controller##_##Method##_registrator;
+
+/**
+ * IAsyncReply of one Crow request. The response is handed to the connection's io_context and
+ * ended there, which runs the middlewares' after_handle: AdmissionMiddleware releases the permit
+ * only then. A reply dropped without an answer sends 500 rather than leave the connection hanging.
+ */
+class CrowAsyncReply : public IAsyncReply {
+    crow::request& request;
+    crow::response& response;
+    AdmissionMiddleware::context& admission;
+    std::shared_ptr<RouteMetrics> routeMetrics;
+    std::string retryAfter;
+    std::chrono::steady_clock::time_point started;
+    std::atomic<bool> sent{false};
+
+    void Deliver(crow::response reply, const admission::Failure failure) {
+        if (sent.exchange(true)) {
+            return;
+        }
+        // held by a shared_ptr since asio handlers must be copyable, crow::response is not
+        auto pending = std::make_shared<crow::response>(std::move(reply));
+        request.post([&response = response, &admission = admission, routeMetrics = routeMetrics, started = started, pending, failure] {
+            admission.failure = failure;
+            routeMetrics->Record(pending->code, metrics::Since(started));
+            // merged rather than assigned, Crow may have set headers (Keep-Alive) once the handler returned
+            response.code = pending->code;
+            response.body = std::move(pending->body);
+            for (auto& [key, value] : pending->headers) {
+                response.add_header(key, value);
+            }
+            response.end();
+        });
+    }
+
+public:
+    // request, response and context belong to the connection, which Crow keeps until the response ends. Handlers
+    // only get the request as const, but it is the connection's own and post() is not const
+    CrowAsyncReply(const crow::request& request, crow::response& response, AdmissionMiddleware::context& admission,
+                   std::shared_ptr<RouteMetrics> routeMetrics, std::string retryAfter)
+        : request(const_cast<crow::request&>(request)), response(response), admission(admission), routeMetrics(std::move(routeMetrics)),
+          retryAfter(std::move(retryAfter)), started(std::chrono::steady_clock::now()) {}
+
+    ~CrowAsyncReply() override {
+        Deliver(crow::response{crow::INTERNAL_SERVER_ERROR}, admission::Failure::NONE);
+    }
+
+    [[nodiscard]] deadline::Clock::time_point Deadline() const override {
+        return admission.deadline;
+    }
+
+    void Send(crow::response reply) override {
+        Deliver(std::move(reply), admission::Failure::NONE);
+    }
+
+    void Fail(const AsyncError& error) override {
+        if (error.kind == AsyncError::Kind::QUERY) {
+            Deliver(crow::response{crow::INTERNAL_SERVER_ERROR}, admission::Failure::NONE);
+            return;
+        }
+        crow::response busy{crow::SERVICE_UNAVAILABLE};
+        busy.add_header(RETRY_AFTER_HEADER, retryAfter);
+        Deliver(std::move(busy), error.kind == AsyncError::Kind::UNAVAILABLE
+            ? admission::Failure::POOL_TIMEOUT : admission::Failure::DEADLINE_EXCEEDED);
+    }
+};
+
+// Calls a controller method answering through the reply. The worker thread is free again once it returns, so the
+// deadline AdmissionMiddleware set for blocking handlers is cleared here instead of in its after_handle.
+template<typename Controller, typename Method, typename... Args>
+void handleAsyncRoute(Controller* controller, Method method, const std::shared_ptr<IAsyncReply>& reply,
+                      const crow::request& request, Args&&... args) {
+    try {
+        (controller->*method)(request, reply, std::forward<Args>(args)...);
+    } catch (...) {
+        // Crow only answers 500 for handlers that return the response
+        reply->Send(crow::response{crow::INTERNAL_SERVER_ERROR});
+    }
+    deadline::Clear();
+}
+
+// REGISTER_ROUTE for controller methods taking (const crow::request&, const std::shared_ptr<IAsyncReply>&, route args...)
+#define REGISTER_ASYNC_ROUTE(Controller, Method, Path, HttpMethod) \
+struct Controller## _##Method##_RouteRegistrator { \
+    Controller##_##Method##_RouteRegistrator() { \
+        routeRegistry().push_back({ Path, HttpMethod, \
+            [](TournamentApp& app, const std::shared_ptr<Hypodermic::Container>& container) { \
                     CROW_ROUTE(app, Path).methods(HttpMethod)( \
-                        [container](const crow::request& request ,auto&&... args) { \
-                        auto controller = container->resolve<Controller>(); \
-                        return invokeController(controller.get(), &Controller::Method, request, std::forward<decltype(args)>(args)...); \
+                        [&app, controller = container->resolve<Controller>(), routeMetrics = std::make_shared<RouteMetrics>(Path, HttpMethod), \
+                         retryAfter = std::to_string(container->resolve<config::AdmissionConfiguration>()->retryAfter.count())] \
+                        (const crow::request& request, crow::response& response, auto&&... args) -> void { \
+                        handleAsyncRoute(controller.get(), &Controller::Method, \
+                            std::make_shared<CrowAsyncReply>(request, response, app.get_context<AdmissionMiddleware>(request), routeMetrics, retryAfter), \
+                            request, std::forward<decltype(args)>(args)...); \
                     } \
                 ); \
             } \
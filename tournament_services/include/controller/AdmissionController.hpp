@@ -0,0 +1,32 @@
+#ifndef TOURNAMENTS_ADMISSIONCONTROLLER_HPP
+#define TOURNAMENTS_ADMISSIONCONTROLLER_HPP
+
+#include <memory>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/RouteDefinition.hpp"
+#include "middleware/AdmissionMiddleware.hpp"
+
+class AdmissionController {
+    std::shared_ptr<admission::ConcurrencyLimiter> limiter;
+public:
+    explicit AdmissionController(const std::shared_ptr<admission::ConcurrencyLimiter>& limiter) : limiter(limiter) {}
+
+    crow::response GetStats() {
+        const auto& stats = limiter->Stats();
+        const nlohmann::json body = {
+            {"limit", limiter->Limit()},
+            {"inflight", limiter->Inflight()},
+            {"admitted", stats.admitted.load()},
+            {"rejected", stats.rejected.load()},
+            {"dropped", stats.dropped.load()}
+        };
+        crow::response response{crow::OK, body.dump()};
+        response.add_header("content-type", "application/json");
+        return response;
+    }
+};
+
+REGISTER_ROUTE(AdmissionController, GetStats, "/admission/stats", "GET"_method)
+#endif //TOURNAMENTS_ADMISSIONCONTROLLER_HPP
@@ -0,0 +1,24 @@
+#ifndef TOURNAMENTS_ASYNC_REPLY_HPP
+#define TOURNAMENTS_ASYNC_REPLY_HPP
+
+#include <crow.h>
+
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+
+/**
+ * Response of a route registered with REGISTER_ASYNC_ROUTE. The controller method returns before
+ * its queries complete and answers through the reply from whichever thread completes them; only
+ * the first Send or Fail counts.
+ */
+class IAsyncReply {
+public:
+    virtual ~IAsyncReply() = default;
+    // the request's deadline, to hand to the async repositories
+    [[nodiscard]] virtual deadline::Clock::time_point Deadline() const = 0;
+    virtual void Send(crow::response response) = 0;
+    // UNAVAILABLE and DEADLINE answer 503 with Retry-After like the blocking routes' timeouts, QUERY answers 500
+    virtual void Fail(const AsyncError& error) = 0;
+};
+
+#endif //TOURNAMENTS_ASYNC_REPLY_HPP
@@ -0,0 +1,44 @@
+#ifndef TOURNAMENTS_CACHECONTROLLER_HPP
+#define TOURNAMENTS_CACHECONTROLLER_HPP
+
+#include <memory>
+#include <string_view>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/RouteDefinition.hpp"
+#include "domain/Team.hpp"
+#include "domain/Tournament.hpp"
+#include "persistence/repository/CachedRepository.hpp"
+
+using CachedTeamRepository = CachedRepository<domain::Team, domain::Id>;
+using CachedTournamentRepository = CachedRepository<domain::Tournament, domain::Id>;
+
+class CacheController {
+    std::shared_ptr<CachedTeamRepository> teamRepository;
+    std::shared_ptr<CachedTournamentRepository> tournamentRepository;
+
+    template<typename Repository>
+    static nlohmann::json CacheBody(const std::shared_ptr<Repository>& repository) {
+        const auto& stats = repository->Stats();
+        return {
+            {"hits", stats.hits.load()},
+            {"misses", stats.misses.load()},
+            {"evictions", stats.evictions.load()},
+            {"size", repository->Size()}
+        };
+    }
+public:
+    CacheController(const std::shared_ptr<CachedTeamRepository>& teamRepository, const std::shared_ptr<CachedTournamentRepository>& tournamentRepository)
+        : teamRepository(teamRepository), tournamentRepository(tournamentRepository) {}
+
+    crow::response GetStats() {
+        nlohmann::json body = {{"teams", CacheBody(teamRepository)}, {"tournaments", CacheBody(tournamentRepository)}};
+        crow::response response{crow::OK, body.dump()};
+        response.add_header("content-type", "application/json");
+        return response;
+    }
+};
+
+REGISTER_ROUTE(CacheController, GetStats, "/cache/stats", "GET"_method)
+#endif //TOURNAMENTS_CACHECONTROLLER_HPP
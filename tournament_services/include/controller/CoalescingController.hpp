@@ -0,0 +1,54 @@
+#ifndef TOURNAMENTS_COALESCINGCONTROLLER_HPP
+#define TOURNAMENTS_COALESCINGCONTROLLER_HPP
+
+#include <memory>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/RouteDefinition.hpp"
+#include "domain/Team.hpp"
+#include "domain/Tournament.hpp"
+#include "persistence/repository/CoalescingRepository.hpp"
+#include "persistence/repository/CoalescingGroupRepository.hpp"
+
+using CoalescingTeamRepository = CoalescingRepository<domain::Team>;
+using CoalescingTournamentRepository = CoalescingRepository<domain::Tournament>;
+
+class CoalescingController {
+    std::shared_ptr<CoalescingTeamRepository> teamRepository;
+    std::shared_ptr<CoalescingTournamentRepository> tournamentRepository;
+    std::shared_ptr<CoalescingGroupRepository> groupRepository;
+
+    template<typename Repository>
+    static nlohmann::json CoalescingBody(const std::shared_ptr<Repository>& repository) {
+        const auto& stats = repository->Stats();
+        const auto batches = stats.batches.load();
+        const auto batchedIds = stats.batchedIds.load();
+        return {
+            {"requests", stats.requests.load()},
+            {"joined", stats.joined.load()},
+            {"batches", batches},
+            {"batchedIds", batchedIds},
+            {"averageBatchSize", batches == 0 ? 0.0 : static_cast<double>(batchedIds) / static_cast<double>(batches)}
+        };
+    }
+public:
+    CoalescingController(const std::shared_ptr<CoalescingTeamRepository>& teamRepository,
+                         const std::shared_ptr<CoalescingTournamentRepository>& tournamentRepository,
+                         const std::shared_ptr<CoalescingGroupRepository>& groupRepository)
+        : teamRepository(teamRepository), tournamentRepository(tournamentRepository), groupRepository(groupRepository) {}
+
+    crow::response GetStats() {
+        const nlohmann::json body = {
+            {"teams", CoalescingBody(teamRepository)},
+            {"tournaments", CoalescingBody(tournamentRepository)},
+            {"groups", CoalescingBody(groupRepository)}
+        };
+        crow::response response{crow::OK, body.dump()};
+        response.add_header("content-type", "application/json");
+        return response;
+    }
+};
+
+REGISTER_ROUTE(CoalescingController, GetStats, "/coalescing/stats", "GET"_method)
+#endif //TOURNAMENTS_COALESCINGCONTROLLER_HPP
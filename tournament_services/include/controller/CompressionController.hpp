@@ -0,0 +1,43 @@
+#ifndef TOURNAMENTS_COMPRESSIONCONTROLLER_HPP
+#define TOURNAMENTS_COMPRESSIONCONTROLLER_HPP
+
+#include <memory>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/RouteDefinition.hpp"
+#include "middleware/CompressionMiddleware.hpp"
+
+class CompressionController {
+    std::shared_ptr<compression::CompressionStats> stats;
+
+    static nlohmann::json EncodingBody(const compression::EncodingStats& encodingStats) {
+        const auto bytesIn = encodingStats.bytesIn.load();
+        const auto bytesOut = encodingStats.bytesOut.load();
+        return {
+            {"responses", encodingStats.responses.load()},
+            {"bytesIn", bytesIn},
+            {"bytesOut", bytesOut},
+            // uncompressed over compressed size, 0 until something was compressed
+            {"ratio", bytesOut == 0 ? 0.0 : static_cast<double>(bytesIn) / static_cast<double>(bytesOut)},
+            {"cpuMicros", encodingStats.cpuMicros.load()}
+        };
+    }
+public:
+    explicit CompressionController(const std::shared_ptr<compression::CompressionStats>& stats) : stats(stats) {}
+
+    crow::response GetStats() {
+        const nlohmann::json body = {
+            {"gzip", EncodingBody(stats->gzip)},
+            {"zstd", EncodingBody(stats->zstd)},
+            {"belowThreshold", stats->belowThreshold.load()},
+            {"notAccepted", stats->notAccepted.load()}
+        };
+        crow::response response{crow::OK, body.dump()};
+        response.add_header("content-type", "application/json");
+        return response;
+    }
+};
+
+REGISTER_ROUTE(CompressionController, GetStats, "/compression/stats", "GET"_method)
+#endif //TOURNAMENTS_COMPRESSIONCONTROLLER_HPP
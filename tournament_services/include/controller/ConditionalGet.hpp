@@ -0,0 +1,109 @@
+#ifndef TOURNAMENTS_CONDITIONAL_GET_HPP
+#define TOURNAMENTS_CONDITIONAL_GET_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <charconv>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <crow.h>
+
+#include "persistence/repository/IVersionRepository.hpp"
+
+#define ETAG_HEADER "ETag"
+#define LAST_MODIFIED_HEADER "Last-Modified"
+#define IF_NONE_MATCH_HEADER "If-None-Match"
+#define IF_MODIFIED_SINCE_HEADER "If-Modified-Since"
+
+/**
+ * Validators for GET responses built from a ResourceVersion, so the controllers can answer
+ * If-None-Match / If-Modified-Since with 304 before reading or serializing the entity. ETags are
+ * weak, the same body may go out with different content codings.
+ */
+namespace conditional {
+    inline std::string ETag(const ResourceVersion& version) {
+        return std::format("W/\"{:x}-{:x}\"", version.lastModified.time_since_epoch().count(), version.count);
+    }
+
+    // IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT"
+    inline std::string HttpDate(const std::chrono::sys_seconds time) {
+        return std::format("{:%a, %d %b %Y %H:%M:%S} GMT", time);
+    }
+
+    inline std::optional<std::chrono::sys_seconds> ParseHttpDate(const std::string_view value) {
+        static constexpr std::array<std::string_view, 12> MONTHS = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+        if (value.size() != 29 || value.substr(25) != " GMT") {
+            return std::nullopt;
+        }
+        const auto number = [&](const size_t position, const size_t length) -> std::optional<int> {
+            int parsed = 0;
+            const auto [end, error] = std::from_chars(value.data() + position, value.data() + position + length, parsed);
+            if (error != std::errc() || end != value.data() + position + length) {
+                return std::nullopt;
+            }
+            return parsed;
+        };
+        const auto month = std::ranges::find(MONTHS, value.substr(8, 3));
+        const auto day = number(5, 2), year = number(12, 4), hours = number(17, 2), minutes = number(20, 2), seconds = number(23, 2);
+        if (month == MONTHS.end() || !day || !year || !hours || !minutes || !seconds) {
+            return std::nullopt;
+        }
+        const std::chrono::year_month_day date{std::chrono::year(*year), std::chrono::month(static_cast<unsigned>(month - MONTHS.begin() + 1)), std::chrono::day(static_cast<unsigned>(*day))};
+        if (!date.ok()) {
+            return std::nullopt;
+        }
+        return std::chrono::sys_days(date) + std::chrono::hours(*hours) + std::chrono::minutes(*minutes) + std::chrono::seconds(*seconds);
+    }
+
+    // weak comparison, as RFC 9110 asks of If-None-Match
+    inline bool MatchesAny(std::string_view header, const std::string_view etag) {
+        const auto opaque = [](std::string_view tag) { return tag.starts_with("W/") ? tag.substr(2) : tag; };
+        while (!header.empty()) {
+            const auto comma = header.find(',');
+            std::string_view candidate = header.substr(0, comma);
+            header = comma == std::string_view::npos ? std::string_view{} : header.substr(comma + 1);
+            const auto start = candidate.find_first_not_of(' ');
+            if (start == std::string_view::npos) {
+                continue;
+            }
+            candidate = candidate.substr(start, candidate.find_last_not_of(' ') - start + 1);
+            if (candidate == "*" || opaque(candidate) == opaque(etag)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // without validators IsNotModified is false whatever the version, so reading it first can be skipped
+    inline bool HasValidators(const crow::request& request) {
+        return !request.get_header_value(IF_NONE_MATCH_HEADER).empty() || !request.get_header_value(IF_MODIFIED_SINCE_HEADER).empty();
+    }
+
+    // If-None-Match wins over If-Modified-Since when both are sent
+    inline bool IsNotModified(const crow::request& request, const ResourceVersion& version) {
+        if (const auto& ifNoneMatch = request.get_header_value(IF_NONE_MATCH_HEADER); !ifNoneMatch.empty()) {
+            return MatchesAny(ifNoneMatch, ETag(version));
+        }
+        if (const auto& ifModifiedSince = request.get_header_value(IF_MODIFIED_SINCE_HEADER); !ifModifiedSince.empty()) {
+            const auto since = ParseHttpDate(ifModifiedSince);
+            return since && std::chrono::floor<std::chrono::seconds>(version.lastModified) <= *since;
+        }
+        return false;
+    }
+
+    inline void AddValidators(crow::response& response, const ResourceVersion& version) {
+        response.add_header(ETAG_HEADER, ETag(version));
+        response.add_header(LAST_MODIFIED_HEADER, HttpDate(std::chrono::floor<std::chrono::seconds>(version.lastModified)));
+    }
+
+    inline crow::response NotModified(const ResourceVersion& version) {
+        crow::response response{crow::NOT_MODIFIED};
+        AddValidators(response, version);
+        return response;
+    }
+}
+
+#endif //TOURNAMENTS_CONDITIONAL_GET_HPP
@@ -0,0 +1,63 @@
+#ifndef TOURNAMENTS_EXPORTCONTROLLER_HPP
+#define TOURNAMENTS_EXPORTCONTROLLER_HPP
+
+#include <memory>
+#include <crow.h>
+
+#include "configuration/RouteDefinition.hpp"
+#include "controller/Pagination.hpp"
+#include "persistence/repository/IExportRepository.hpp"
+
+#define NDJSON_CONTENT_TYPE "application/x-ndjson"
+
+/**
+ * Bulk NDJSON export for reconciliation. Every call streams at most one batch from the database
+ * and hands out a cursor for the next one. The batch is buffered before it is sent, so memory per
+ * request is bounded by the batch size (at most MAX_BATCH rows) rather than by the table, and a
+ * slow client simply asks for the next batch later.
+ */
+class ExportController {
+    static constexpr size_t DEFAULT_BATCH = 5000;
+    static constexpr size_t MAX_BATCH = 50000;
+
+    std::shared_ptr<IExportRepository> exportRepository;
+
+    crow::response Export(const crow::request& request, const ExportSource source) const {
+        auto pageRequest = pagination::ParsePageRequest(request, MAX_BATCH);
+        if (!pageRequest) {
+            return crow::response{crow::BAD_REQUEST, "Invalid limit or cursor"};
+        }
+        if (request.url_params.get("limit") == nullptr) {
+            pageRequest->limit = DEFAULT_BATCH;
+        }
+
+        crow::response response{crow::OK};
+        const auto next = exportRepository->ExportNdjson(source, *pageRequest, response.body);
+        response.add_header("content-type", NDJSON_CONTENT_TYPE);
+        if (next) {
+            response.add_header(NEXT_CURSOR_HEADER, cursor::Encode(*next));
+        }
+        return response;
+    }
+
+public:
+    explicit ExportController(const std::shared_ptr<IExportRepository>& exportRepository) : exportRepository(exportRepository) {}
+
+    crow::response ExportTeams(const crow::request& request) const {
+        return Export(request, ExportSource::TEAMS);
+    }
+
+    crow::response ExportTournaments(const crow::request& request) const {
+        return Export(request, ExportSource::TOURNAMENTS);
+    }
+
+    crow::response ExportGroups(const crow::request& request) const {
+        return Export(request, ExportSource::GROUPS);
+    }
+};
+
+REGISTER_ROUTE(ExportController, ExportTeams, "/export/teams", "GET"_method)
+REGISTER_ROUTE(ExportController, ExportTournaments, "/export/tournaments", "GET"_method)
+REGISTER_ROUTE(ExportController, ExportGroups, "/export/groups", "GET"_method)
+
+#endif //TOURNAMENTS_EXPORTCONTROLLER_HPP
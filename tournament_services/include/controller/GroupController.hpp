@@ -11,8 +11,12 @@
 #include <nlohmann/json.hpp>
 
 #include "configuration/RouteDefinition.hpp"
+#include "controller/AsyncReply.hpp"
+#include "controller/ConditionalGet.hpp"
+#include "controller/RequestBody.hpp"
 #include "delegate/IGroupDelegate.hpp"
 #include "domain/Group.hpp"
+#include "domain/JsonSerializer.hpp"
 #include "domain/Utilities.hpp"
 
 
@@ -22,8 +26,8 @@ class GroupController
 public:
     GroupController(const std::shared_ptr<IGroupDelegate>& delegate);
     ~GroupController();
-    crow::response GetGroups(const std::string& tournamentId);
-    crow::response GetGroup(const std::string& tournamentId, const std::string& groupId);
+    void GetGroups(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply, const std::string& tournamentId);
+    void GetGroup(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply, const std::string& tournamentId, const std::string& groupId);
     crow::response CreateGroup(const crow::request& request, const std::string& tournamentId);
     crow::response UpdateGroup(const crow::request& request);
     crow::response AddTeams(const crow::request& request, const std::string& tournamentId, const std::string& groupId);
@@ -35,32 +39,74 @@ GroupController::~GroupController()
 {
 }
 
-crow::response GroupController::GetGroups(const std::string& tournamentId){
-    if (auto groups = this->groupDelegate->GetGroups(tournamentId)) {
-        const nlohmann::json body = *groups;
-        crow::response response{crow::OK, body.dump()};
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-        return response;
+void GroupController::GetGroups(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply, const std::string& tournamentId){
+    const auto id = domain::Id::Parse(tournamentId);
+    if (!id) {
+        reply->Send(crow::response{crow::BAD_REQUEST, "Invalid ID format"});
+        return;
     }
-    return crow::response{crow::INTERNAL_SERVER_ERROR};
-}
-crow::response GroupController::GetGroup(const std::string& tournamentId, const std::string& groupId){
-    if (auto group = this->groupDelegate->GetGroup(tournamentId, groupId)) {
-        const nlohmann::json body = *group;
-        crow::response response{crow::OK, body.dump()};
+    this->groupDelegate->GetGroupsAsync(*id, reply->Deadline(), [reply](auto groups) {
+        if (!groups) {
+            reply->Fail(groups.error());
+            return;
+        }
+        crow::response response{crow::OK, domain::ToJson(*groups, groups->size() * 512 + 2)};
         response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-        return response;
+        reply->Send(std::move(response));
+    });
+}
+void GroupController::GetGroup(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply, const std::string& tournamentId, const std::string& groupId){
+    const auto tournament = domain::Id::Parse(tournamentId);
+    const auto id = domain::Id::Parse(groupId);
+    if (!tournament || !id) {
+        reply->Send(crow::response{crow::BAD_REQUEST, "Invalid ID format"});
+        return;
     }
-    return crow::response{crow::INTERNAL_SERVER_ERROR};
+    // the request stays alive until the reply is sent
+    this->groupDelegate->GetGroupVersionAsync(*tournament, *id, reply->Deadline(), [this, &request, reply, tournament = *tournament, id = *id](auto version) {
+        if (!version) {
+            reply->Fail(version.error());
+            return;
+        }
+        if (!*version) {
+            reply->Send(crow::response{crow::NOT_FOUND, "group not found"});
+            return;
+        }
+        if (conditional::IsNotModified(request, **version)) {
+            reply->Send(conditional::NotModified(**version));
+            return;
+        }
+        this->groupDelegate->GetGroupAsync(tournament, id, reply->Deadline(), [reply, version = **version](auto group) {
+            if (!group) {
+                reply->Fail(group.error());
+                return;
+            }
+            // deleted since its version was read
+            if (*group == nullptr) {
+                reply->Send(crow::response{crow::NOT_FOUND, "group not found"});
+                return;
+            }
+            crow::response response{crow::OK, domain::ToJson(*group, 512)};
+            response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+            conditional::AddValidators(response, version);
+            reply->Send(std::move(response));
+        });
+    });
 }
 crow::response GroupController::CreateGroup(const crow::request& request, const std::string& tournamentId){
-    auto requestBody = nlohmann::json::parse(request.body);
-    domain::Group group = requestBody;
+    const auto tournament = domain::Id::Parse(tournamentId);
+    if (!tournament) {
+        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+    }
+    const auto group = request_body::ParseGroup(request.body);
+    if (!group) {
+        return crow::response{crow::BAD_REQUEST, group.error()};
+    }
 
-    auto groupId = groupDelegate->CreateGroup(tournamentId, group);
+    auto groupId = groupDelegate->CreateGroup(*tournament, *group);
     crow::response response;
     if (groupId) {
-        response.add_header("location", *groupId);
+        response.add_header("location", groupId->ToString());
         response.code = crow::CREATED;
     } else {
         groupId.error();
@@ -75,8 +121,16 @@ crow::response GroupController::UpdateGroup(const crow::request& request){
 }
 
 crow::response GroupController::AddTeams(const crow::request& request, const std::string& tournamentId, const std::string& groupId) {
-    const std::vector<domain::Team> teams = nlohmann::json::parse(request.body);
-    const auto result = groupDelegate->UpdateTeams(tournamentId, groupId, teams);
+    const auto tournament = domain::Id::Parse(tournamentId);
+    const auto id = domain::Id::Parse(groupId);
+    if (!tournament || !id) {
+        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+    }
+    const auto teams = request_body::ParseTeams(request.body);
+    if (!teams) {
+        return crow::response{crow::BAD_REQUEST, teams.error()};
+    }
+    const auto result = groupDelegate->UpdateTeams(*tournament, *id, *teams);
     if (result) {
         return crow::response{crow::NO_CONTENT};
     }
@@ -84,8 +138,8 @@ crow::response GroupController::AddTeams(const crow::request& request, const std
     return crow::response{422, result.error()};
 }
 
-REGISTER_ROUTE(GroupController, GetGroups, "/tournaments/<string>/groups", "GET"_method)
-REGISTER_ROUTE(GroupController, GetGroup, "/tournaments/<string>/groups/<string>", "GET"_method)
+REGISTER_ASYNC_ROUTE(GroupController, GetGroups, "/tournaments/<string>/groups", "GET"_method)
+REGISTER_ASYNC_ROUTE(GroupController, GetGroup, "/tournaments/<string>/groups/<string>", "GET"_method)
 REGISTER_ROUTE(GroupController, CreateGroup, "/tournaments/<string>/groups", "POST"_method)
 REGISTER_ROUTE(GroupController, UpdateGroup, "/tournaments/<string>/groups/<string>", "PATCH"_method)
 REGISTER_ROUTE(GroupController, AddTeams, "/tournaments/<string>/groups/<string>/teams", "PATCH"_method)
@@ -5,14 +5,32 @@
 #ifndef TOURNAMENTS_HEALTHCONTROLLER_HPP
 #define TOURNAMENTS_HEALTHCONTROLLER_HPP
 
+#include <format>
+#include <memory>
+
 #include "configuration/RouteDefinition.hpp"
+#include "persistence/configuration/IDbConnectionProvider.hpp"
+#include "cms/ConnectionManager.hpp"
 
+// readiness probe for the load balancer, not ready until the database pool is warm
 class HealthController {
+    std::shared_ptr<IDbConnectionProvider> connectionProvider;
+    std::shared_ptr<ConnectionManager> connectionManager;
     public:
+    HealthController(const std::shared_ptr<IDbConnectionProvider>& connectionProvider, const std::shared_ptr<ConnectionManager>& connectionManager)
+        : connectionProvider(connectionProvider), connectionManager(connectionManager) {}
+
     crow::response GetHealth(){
-        return crow::response{crow::OK, "Services running"};
+        // the broker only backs team additions, it is reported but does not gate readiness
+        const auto broker = connectionManager->IsConnected() ? "connected" : "connecting";
+        if (!connectionProvider->Ready()) {
+            crow::response warming{crow::SERVICE_UNAVAILABLE, std::format("Warming up, database: warming, broker: {}", broker)};
+            warming.add_header("Retry-After", "1");
+            return warming;
+        }
+        return crow::response{crow::OK, std::format("Services running, database: ready, broker: {}", broker)};
     }
 };
 
 REGISTER_ROUTE(HealthController, GetHealth, "/health", "GET"_method)
-#endif //TOURNAMENTS_HEALTHCONTROLLER_HPP
\ No newline at end of file
+#endif //TOURNAMENTS_HEALTHCONTROLLER_HPP
@@ -0,0 +1,21 @@
+#ifndef TOURNAMENTS_METRICSCONTROLLER_HPP
+#define TOURNAMENTS_METRICSCONTROLLER_HPP
+
+#include <string>
+#include <crow.h>
+
+#include "configuration/RouteDefinition.hpp"
+#include "metrics/Metrics.hpp"
+
+// Prometheus scrape endpoint, exempt from admission so it keeps answering while requests are shed
+class MetricsController {
+public:
+    crow::response GetMetrics() {
+        crow::response response{crow::OK, metrics::Registry::Instance().Render()};
+        response.add_header("content-type", std::string(metrics::CONTENT_TYPE));
+        return response;
+    }
+};
+
+REGISTER_ROUTE(MetricsController, GetMetrics, "/metrics", "GET"_method)
+#endif //TOURNAMENTS_METRICSCONTROLLER_HPP
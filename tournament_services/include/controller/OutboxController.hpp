@@ -0,0 +1,31 @@
+#ifndef TOURNAMENTS_OUTBOXCONTROLLER_HPP
+#define TOURNAMENTS_OUTBOXCONTROLLER_HPP
+
+#include <memory>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/RouteDefinition.hpp"
+#include "cms/OutboxRelay.hpp"
+
+class OutboxController {
+    std::shared_ptr<OutboxRelay> relay;
+public:
+    explicit OutboxController(const std::shared_ptr<OutboxRelay>& relay) : relay(relay) {}
+
+    crow::response GetStats() {
+        const auto& stats = relay->Stats();
+        const nlohmann::json body = {
+            {"published", stats.published.load()},
+            {"batches", stats.batches.load()},
+            {"failures", stats.failures.load()},
+            {"lagMs", stats.lagMillis.load()}
+        };
+        crow::response response{crow::OK, body.dump()};
+        response.add_header("content-type", "application/json");
+        return response;
+    }
+};
+
+REGISTER_ROUTE(OutboxController, GetStats, "/outbox/stats", "GET"_method)
+#endif //TOURNAMENTS_OUTBOXCONTROLLER_HPP
@@ -0,0 +1,48 @@
+#ifndef TOURNAMENTS_PAGINATION_HPP
+#define TOURNAMENTS_PAGINATION_HPP
+
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <crow.h>
+
+#include "persistence/repository/Page.hpp"
+
+#define NEXT_CURSOR_HEADER "x-next-cursor"
+
+namespace pagination {
+    inline constexpr size_t DEFAULT_LIMIT = 100;
+    inline constexpr size_t MAX_LIMIT = 1000;
+
+    // reads ?limit=&cursor=, nullopt when any of them is malformed
+    inline std::optional<PageRequest> ParsePageRequest(const crow::request& request, const size_t maxLimit = MAX_LIMIT) {
+        PageRequest page{DEFAULT_LIMIT, std::nullopt};
+
+        if (const char* limit = request.url_params.get("limit"); limit != nullptr) {
+            const std::string_view value(limit);
+            size_t parsed = 0;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+            if (error != std::errc() || end != value.data() + value.size() || parsed == 0 || parsed > maxLimit) {
+                return std::nullopt;
+            }
+            page.limit = parsed;
+        }
+
+        if (const char* cursor = request.url_params.get("cursor"); cursor != nullptr) {
+            page.after = cursor::Decode(cursor);
+            if (!page.after) {
+                return std::nullopt;
+            }
+        }
+        return page;
+    }
+
+    template<typename Type>
+    void AddNextCursor(crow::response& response, const Page<Type>& page) {
+        if (page.next) {
+            response.add_header(NEXT_CURSOR_HEADER, cursor::Encode(*page.next));
+        }
+    }
+}
+
+#endif //TOURNAMENTS_PAGINATION_HPP
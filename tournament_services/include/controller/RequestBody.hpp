@@ -0,0 +1,334 @@
+#ifndef TOURNAMENTS_REQUEST_BODY_HPP
+#define TOURNAMENTS_REQUEST_BODY_HPP
+
+#include <expected>
+#include <format>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <simdjson.h>
+
+#include "domain/Group.hpp"
+#include "domain/Team.hpp"
+#include "domain/Tournament.hpp"
+
+/**
+ * Reads request bodies into domain objects in one pass with simdjson's on demand parser, instead
+ * of validating with nlohmann::json::accept and then building a DOM to pick a few fields out of.
+ * Errors name the offending field so they can go back as the 400 body. Unknown fields are skipped
+ * without being materialised, like nlohmann's from_json ignored them.
+ */
+namespace request_body {
+    using Error = std::string;
+
+    namespace detail {
+        using Result = std::expected<void, Error>;
+
+        // one parser per thread, it keeps its buffers between requests
+        inline simdjson::ondemand::parser& Parser() {
+            thread_local simdjson::ondemand::parser parser;
+            return parser;
+        }
+
+        // simdjson reads past the end of the input, crow's body usually has the spare capacity
+        // already and is only copied when it does not
+        class Source {
+            const std::string& body;
+            simdjson::padded_string copy;
+        public:
+            explicit Source(const std::string& body) : body(body) {}
+
+            simdjson::padded_string_view View(const size_t offset, const size_t length) {
+                const std::string_view text(body.data() + offset, length);
+                if (body.capacity() - offset - length >= simdjson::SIMDJSON_PADDING) {
+                    return simdjson::padded_string_view(text, body.capacity() - offset);
+                }
+                copy = simdjson::padded_string(text);
+                return copy;
+            }
+
+            simdjson::padded_string_view View() { return View(0, body.size()); }
+        };
+
+        inline Error Describe(const std::string_view path, const simdjson::error_code error, const std::string_view expected) {
+            if (error == simdjson::INCORRECT_TYPE || error == simdjson::NUMBER_OUT_OF_RANGE) {
+                return std::format("{}: expected {}", path, expected);
+            }
+            return std::format("{}: {}", path, simdjson::error_message(error));
+        }
+
+        inline Result ReadString(simdjson::simdjson_result<simdjson::ondemand::value> value, std::string& target, const std::string_view path) {
+            std::string_view text;
+            if (const auto error = value.get_string().get(text)) {
+                return std::unexpected(Describe(path, error, "a string"));
+            }
+            target = text;
+            return {};
+        }
+
+        // "" stands for no id, like the nil UUID it becomes
+        inline Result ReadId(simdjson::simdjson_result<simdjson::ondemand::value> value, domain::Id& target, const std::string_view path) {
+            std::string_view text;
+            if (const auto error = value.get_string().get(text)) {
+                return std::unexpected(Describe(path, error, "a UUID"));
+            }
+            if (text.empty()) {
+                target = domain::Id{};
+                return {};
+            }
+            const auto parsed = domain::Id::Parse(text);
+            if (!parsed) {
+                return std::unexpected(std::format("{}: expected a UUID", path));
+            }
+            target = *parsed;
+            return {};
+        }
+
+        inline Result ReadInt(simdjson::simdjson_result<simdjson::ondemand::value> value, int& target, const std::string_view path) {
+            int64_t number = 0;
+            if (const auto error = value.get_int64().get(number)) {
+                return std::unexpected(Describe(path, error, "an integer"));
+            }
+            if (number < 0 || number > std::numeric_limits<int>::max()) {
+                return std::unexpected(std::format("{}: expected a non-negative integer", path));
+            }
+            target = static_cast<int>(number);
+            return {};
+        }
+
+        template<typename Object, typename Visitor>
+        Result ForEachField(Object&& source, const std::string_view path, Visitor&& visitor) {
+            simdjson::ondemand::object object;
+            if (const auto error = source.get_object().get(object)) {
+                return std::unexpected(Describe(path, error, "an object"));
+            }
+            for (auto field : object) {
+                std::string_view key;
+                if (const auto error = field.unescaped_key().get(key)) {
+                    return std::unexpected(Describe(path, error, "an object"));
+                }
+                if (auto read = visitor(key, field.value()); !read) {
+                    return read;
+                }
+            }
+            return {};
+        }
+
+        inline Result ReadTeam(simdjson::simdjson_result<simdjson::ondemand::value> value, domain::Team& team, const std::string_view path) {
+            return ForEachField(value, path, [&](const std::string_view key, auto field) -> Result {
+                if (key == "id") {
+                    return ReadId(field, team.Id, std::format("{}.id", path));
+                }
+                if (key == "name") {
+                    return ReadString(field, team.Name, std::format("{}.name", path));
+                }
+                return {};
+            });
+        }
+
+        inline Result ReadTeams(simdjson::simdjson_result<simdjson::ondemand::value> value, std::vector<domain::Team>& teams, const std::string_view path) {
+            simdjson::ondemand::array array;
+            if (const auto error = value.get_array().get(array)) {
+                return std::unexpected(Describe(path, error, "an array"));
+            }
+            for (auto element : array) {
+                const auto teamPath = std::format("{}[{}]", path, teams.size());
+                if (auto read = ReadTeam(element, teams.emplace_back(), teamPath); !read) {
+                    return read;
+                }
+            }
+            return {};
+        }
+
+        inline Result ReadFormat(simdjson::simdjson_result<simdjson::ondemand::value> value, domain::TournamentFormat& format) {
+            return ForEachField(value, "format", [&](const std::string_view key, auto field) -> Result {
+                if (key == "maxTeamsPerGroup") {
+                    return ReadInt(field, format.MaxTeamsPerGroup(), "format.maxTeamsPerGroup");
+                }
+                if (key == "numberOfGroups") {
+                    return ReadInt(field, format.NumberOfGroups(), "format.numberOfGroups");
+                }
+                if (key == "type") {
+                    std::string type;
+                    if (auto read = ReadString(field, type, "format.type"); !read) {
+                        return read;
+                    }
+                    if (type == "ROUND_ROBIN") {
+                        format.Type() = domain::TournamentType::ROUND_ROBIN;
+                    } else if (type == "NFL") {
+                        format.Type() = domain::TournamentType::NFL;
+                    } else {
+                        return std::unexpected(std::format("format.type: unknown tournament type {}", type));
+                    }
+                }
+                return {};
+            });
+        }
+
+        inline Result RequireNonEmpty(const std::string& value, const std::string_view path) {
+            if (value.empty()) {
+                return std::unexpected(std::format("{}: required", path));
+            }
+            return {};
+        }
+
+        inline Result RequireId(const domain::Id& value, const std::string_view path) {
+            if (value.IsNil()) {
+                return std::unexpected(std::format("{}: required", path));
+            }
+            return {};
+        }
+
+        // parses the whole body as one document, anything after the first value is an error
+        template<typename Type, typename Reader>
+        std::expected<Type, Error> ParseDocument(const std::string& body, Reader&& reader) {
+            Source source(body);
+            simdjson::ondemand::document document;
+            if (const auto error = Parser().iterate(source.View()).get(document)) {
+                return std::unexpected(Describe("body", error, "JSON"));
+            }
+            Type value{};
+            if (auto read = reader(document, value); !read) {
+                return std::unexpected(read.error());
+            }
+            if (!document.at_end()) {
+                return std::unexpected(std::string("body: unexpected content after the JSON value"));
+            }
+            return value;
+        }
+
+        // a bulk item is either a team with a name or nullopt, it never fails the whole body
+        inline std::optional<domain::Team> ReadBulkItem(simdjson::simdjson_result<simdjson::ondemand::value> value) {
+            domain::Team team;
+            if (!ReadTeam(value, team, "item") || team.Name.empty()) {
+                return std::nullopt;
+            }
+            return team;
+        }
+    }
+
+    inline std::expected<domain::Team, Error> ParseTeam(const std::string& body) {
+        return detail::ParseDocument<domain::Team>(body, [](auto& document, domain::Team& team) -> detail::Result {
+            if (auto read = detail::ForEachField(document, "body", [&](const std::string_view key, auto field) -> detail::Result {
+                if (key == "id") {
+                    return detail::ReadId(field, team.Id, "id");
+                }
+                if (key == "name") {
+                    return detail::ReadString(field, team.Name, "name");
+                }
+                return {};
+            }); !read) {
+                return read;
+            }
+            return detail::RequireNonEmpty(team.Name, "name");
+        });
+    }
+
+    // the teams of a group are referenced by id
+    inline std::expected<std::vector<domain::Team>, Error> ParseTeams(const std::string& body) {
+        return detail::ParseDocument<std::vector<domain::Team>>(body, [](auto& document, std::vector<domain::Team>& teams) -> detail::Result {
+            simdjson::ondemand::array array;
+            if (const auto error = document.get_array().get(array)) {
+                return std::unexpected(detail::Describe("body", error, "an array of teams"));
+            }
+            for (auto element : array) {
+                const auto path = std::format("[{}]", teams.size());
+                auto& team = teams.emplace_back();
+                if (auto read = detail::ReadTeam(element, team, path); !read) {
+                    return read;
+                }
+                if (auto read = detail::RequireId(team.Id, std::format("{}.id", path)); !read) {
+                    return read;
+                }
+            }
+            return {};
+        });
+    }
+
+    inline std::expected<domain::Tournament, Error> ParseTournament(const std::string& body) {
+        return detail::ParseDocument<domain::Tournament>(body, [](auto& document, domain::Tournament& tournament) -> detail::Result {
+            if (auto read = detail::ForEachField(document, "body", [&](const std::string_view key, auto field) -> detail::Result {
+                if (key == "id") {
+                    return detail::ReadId(field, tournament.Id(), "id");
+                }
+                if (key == "name") {
+                    return detail::ReadString(field, tournament.Name(), "name");
+                }
+                if (key == "format") {
+                    return detail::ReadFormat(field, tournament.Format());
+                }
+                return {};
+            }); !read) {
+                return read;
+            }
+            return detail::RequireNonEmpty(tournament.Name(), "name");
+        });
+    }
+
+    inline std::expected<domain::Group, Error> ParseGroup(const std::string& body) {
+        return detail::ParseDocument<domain::Group>(body, [](auto& document, domain::Group& group) -> detail::Result {
+            if (auto read = detail::ForEachField(document, "body", [&](const std::string_view key, auto field) -> detail::Result {
+                if (key == "id") {
+                    return detail::ReadId(field, group.Id(), "id");
+                }
+                if (key == "tournamentId") {
+                    return detail::ReadId(field, group.TournamentId(), "tournamentId");
+                }
+                if (key == "name") {
+                    return detail::ReadString(field, group.Name(), "name");
+                }
+                if (key == "teams") {
+                    return detail::ReadTeams(field, group.Teams(), "teams");
+                }
+                return {};
+            }); !read) {
+                return read;
+            }
+            return detail::RequireNonEmpty(group.Name(), "name");
+        });
+    }
+
+    // bulk team creation, a JSON array or one team per NDJSON line. Items keep their input
+    // position, an item without a name (or an unparseable NDJSON line) comes back as nullopt.
+    inline std::expected<std::vector<std::optional<domain::Team>>, Error> ParseBulkTeams(const std::string& body, const bool ndjson) {
+        std::vector<std::optional<domain::Team>> items;
+        detail::Source source(body);
+        simdjson::ondemand::document document;
+        if (ndjson) {
+            for (size_t offset = 0; offset < body.size();) {
+                const auto end = std::min(body.find('\n', offset), body.size());
+                const std::string_view line(body.data() + offset, end - offset);
+                if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+                    auto& item = items.emplace_back();
+                    if (!detail::Parser().iterate(source.View(offset, line.size())).get(document)) {
+                        item = detail::ReadBulkItem(document.get_value());
+                        if (!document.at_end()) {
+                            item.reset();
+                        }
+                    }
+                }
+                offset = end + 1;
+            }
+            return items;
+        }
+
+        simdjson::ondemand::array array;
+        if (detail::Parser().iterate(source.View()).get(document) || document.get_array().get(array)) {
+            return std::unexpected(std::string("Expected a JSON array or NDJSON body"));
+        }
+        for (auto element : array) {
+            if (const auto error = element.error(); error != simdjson::SUCCESS) {
+                return std::unexpected(detail::Describe(std::format("[{}]", items.size()), error, "a team"));
+            }
+            items.push_back(detail::ReadBulkItem(element));
+        }
+        if (!document.at_end()) {
+            return std::unexpected(std::string("body: unexpected content after the JSON value"));
+        }
+        return items;
+    }
+}
+
+#endif //TOURNAMENTS_REQUEST_BODY_HPP
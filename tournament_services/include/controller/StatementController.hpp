@@ -0,0 +1,54 @@
+#ifndef TOURNAMENTS_STATEMENTCONTROLLER_HPP
+#define TOURNAMENTS_STATEMENTCONTROLLER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/RouteDefinition.hpp"
+#include "persistence/configuration/StatementRegistry.hpp"
+
+class StatementController {
+public:
+    // statements sorted by the total time they kept a pooled connection busy
+    crow::response GetStats() {
+        std::vector<std::pair<const PreparedStatement*, metrics::Histogram::Snapshot>> registered;
+        StatementRegistry::Instance().ForEach([&registered](const PreparedStatement& statement) {
+            registered.emplace_back(&statement, statement.Latency().Read());
+        });
+        std::ranges::sort(registered, std::greater{}, [](const auto& entry) {
+            return entry.second.sumNanos;
+        });
+
+        nlohmann::json statements = nlohmann::json::array();
+        for (const auto& [statement, latency] : registered) {
+            nlohmann::json histogram = nlohmann::json::array();
+            for (size_t i = 0; i < latency.buckets.size(); i++) {
+                histogram.push_back({
+                    {"le", i < metrics::LATENCY_BOUNDS.size()
+                        ? nlohmann::json(std::chrono::duration_cast<std::chrono::microseconds>(metrics::LATENCY_BOUNDS[i]).count())
+                        : nlohmann::json("+Inf")},
+                    {"count", latency.buckets[i]}
+                });
+            }
+            statements.push_back({
+                {"name", statement->Name()},
+                {"calls", latency.count},
+                {"errors", statement->Errors().Value()},
+                {"totalMicros", latency.sumNanos / 1000},
+                {"latencyMicros", histogram}
+            });
+        }
+
+        crow::response response{crow::OK, nlohmann::json{{"statements", statements}}.dump()};
+        response.add_header("content-type", "application/json");
+        return response;
+    }
+};
+
+REGISTER_ROUTE(StatementController, GetStats, "/database/statements", "GET"_method)
+#endif //TOURNAMENTS_STATEMENTCONTROLLER_HPP
@@ -9,20 +9,21 @@
 #include <crow.h>
 #include <nlohmann/json.hpp>
 #include <memory>
-#include <regex>
 
+#include "controller/AsyncReply.hpp"
 #include "delegate/ITeamDelegate.hpp"
 
-static const std::regex ID_VALUE("[A-Za-z0-9\\-]+");
-
 class TeamController {
     std::shared_ptr<ITeamDelegate> teamDelegate;
+
+    void SendTeam(const std::shared_ptr<IAsyncReply>& reply, const domain::Id& id, const std::optional<ResourceVersion>& version) const;
 public:
     explicit TeamController(const std::shared_ptr<ITeamDelegate>& teamDelegate);
 
-    [[nodiscard]] crow::response getTeam(const std::string& teamId) const;
-    [[nodiscard]] crow::response getAllTeams() const;
+    void getTeam(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply, const std::string& teamId) const;
+    void getAllTeams(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply) const;
     [[nodiscard]] crow::response SaveTeam(const crow::request& request) const;
+    [[nodiscard]] crow::response SaveTeams(const crow::request& request) const;
 };
 
 
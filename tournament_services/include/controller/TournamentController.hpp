@@ -8,6 +8,7 @@
 #include <memory>
 #include <crow.h>
 
+#include "controller/AsyncReply.hpp"
 #include "delegate/ITournamentDelegate.hpp"
 
 
@@ -16,7 +17,7 @@ class TournamentController {
 public:
     explicit TournamentController(std::shared_ptr<ITournamentDelegate> tournament);
     [[nodiscard]] crow::response CreateTournament(const crow::request &request) const;
-    [[nodiscard]] crow::response ReadAll() const;
+    void ReadAll(const crow::request &request, const std::shared_ptr<IAsyncReply>& reply) const;
 };
 
 
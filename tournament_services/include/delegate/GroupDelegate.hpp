@@ -5,30 +5,43 @@
 #include <string_view>
 #include <memory>
 #include <expected>
+#include <algorithm>
+#include <format>
 
 #include "IGroupDelegate.hpp"
+#include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/IAsyncGroupRepository.hpp"
+#include "persistence/repository/IGroupRepository.hpp"
+#include "domain/Team.hpp"
+#include "domain/Tournament.hpp"
 
 class GroupDelegate : public IGroupDelegate{
-    std::shared_ptr<TournamentRepository> tournamentRepository;
+    std::shared_ptr<IRepository<domain::Tournament, domain::Id>> tournamentRepository;
     std::shared_ptr<IGroupRepository> groupRepository;
-    std::shared_ptr<TeamRepository> teamRepository;
-    std::shared_ptr<IQueueMessageProducer> messageProducer;
+    std::shared_ptr<IAsyncGroupRepository> groupAsyncRepository;
+    std::shared_ptr<IRepository<domain::Team, domain::Id>> teamRepository;
 
 public:
-    inline GroupDelegate(const std::shared_ptr<TournamentRepository>& tournamentRepository, const std::shared_ptr<IGroupRepository>& groupRepository, const std::shared_ptr<TeamRepository>& teamRepository, const std::shared_ptr<IQueueMessageProducer>& messageProducer);
-    std::expected<std::string, std::string> CreateGroup(const std::string_view& tournamentId, const domain::Group& group) override;
-    std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> GetGroups(const std::string_view& tournamentId) override;
-    std::expected<std::shared_ptr<domain::Group>, std::string> GetGroup(const std::string_view& tournamentId, const std::string_view& groupId) override;
-    std::expected<void, std::string> UpdateGroup(const std::string_view& tournamentId, const domain::Group& group) override;
-    std::expected<void, std::string> RemoveGroup(const std::string_view& tournamentId, const std::string_view& groupId) override;
-    std::expected<void, std::string> UpdateTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<domain::Team>& team) override;
+    inline GroupDelegate(const std::shared_ptr<IRepository<domain::Tournament, domain::Id>>& tournamentRepository, const std::shared_ptr<IGroupRepository>& groupRepository,
+                         const std::shared_ptr<IAsyncGroupRepository>& groupAsyncRepository, const std::shared_ptr<IRepository<domain::Team, domain::Id>>& teamRepository);
+    std::expected<domain::Id, std::string> CreateGroup(const domain::Id& tournamentId, const domain::Group& group) override;
+    void GetGroupsAsync(const domain::Id& tournamentId, deadline::Clock::time_point deadline,
+                        AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion) override;
+    void GetGroupAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                       AsyncCompletion<std::shared_ptr<domain::Group>> completion) override;
+    void GetGroupVersionAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                              AsyncCompletion<std::optional<ResourceVersion>> completion) override;
+    std::expected<void, std::string> UpdateGroup(const domain::Id& tournamentId, const domain::Group& group) override;
+    std::expected<void, std::string> RemoveGroup(const domain::Id& tournamentId, const domain::Id& groupId) override;
+    std::expected<void, std::string> UpdateTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Team>& team) override;
 };
 
-GroupDelegate::GroupDelegate(const std::shared_ptr<TournamentRepository>& tournamentRepository, const std::shared_ptr<IGroupRepository>& groupRepository, const std::shared_ptr<TeamRepository>& teamRepository, const std::shared_ptr<IQueueMessageProducer>& messageProducer)
-    : tournamentRepository(tournamentRepository), groupRepository(groupRepository), teamRepository(teamRepository), messageProducer(messageProducer){}
+GroupDelegate::GroupDelegate(const std::shared_ptr<IRepository<domain::Tournament, domain::Id>>& tournamentRepository, const std::shared_ptr<IGroupRepository>& groupRepository,
+                             const std::shared_ptr<IAsyncGroupRepository>& groupAsyncRepository, const std::shared_ptr<IRepository<domain::Team, domain::Id>>& teamRepository)
+    : tournamentRepository(tournamentRepository), groupRepository(groupRepository), groupAsyncRepository(groupAsyncRepository), teamRepository(teamRepository){}
 
-inline std::expected<std::string, std::string> GroupDelegate::CreateGroup(const std::string_view& tournamentId, const domain::Group& group) {
-    auto tournament = tournamentRepository->ReadById(tournamentId.data());
+inline std::expected<domain::Id, std::string> GroupDelegate::CreateGroup(const domain::Id& tournamentId, const domain::Group& group) {
+    auto tournament = tournamentRepository->ReadById(tournamentId);
     if (tournament == nullptr) {
         return std::unexpected("Tournament doesn't exist");
     }
@@ -46,52 +59,62 @@ inline std::expected<std::string, std::string> GroupDelegate::CreateGroup(const
     return id;
 }
 
-inline std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> GroupDelegate::GetGroups(const std::string_view& tournamentId) {
-    try {
-        return this->groupRepository->FindByTournamentId(tournamentId);
-    } catch (const std::exception& e) {
-        return std::unexpected("Error when reading to DB");
-    }
+// Errors reach the completion as they are, the controller's reply answers query errors with 500 and unavailable or
+// late ones with 503 and Retry-After, which the admission limiter counts.
+inline void GroupDelegate::GetGroupsAsync(const domain::Id& tournamentId, const deadline::Clock::time_point deadline,
+                                          AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion) {
+    groupAsyncRepository->FindByTournamentIdAsync(tournamentId, deadline, std::move(completion));
 }
-inline std::expected<std::shared_ptr<domain::Group>, std::string> GroupDelegate::GetGroup(const std::string_view& tournamentId, const std::string_view& groupId) {
-    try {
-        return groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId);
-    } catch (const std::exception& e) {
-        return std::unexpected("Error when reading to DB");
-    }
+inline void GroupDelegate::GetGroupAsync(const domain::Id& tournamentId, const domain::Id& groupId, const deadline::Clock::time_point deadline,
+                                         AsyncCompletion<std::shared_ptr<domain::Group>> completion) {
+    groupAsyncRepository->FindByTournamentIdAndGroupIdAsync(tournamentId, groupId, deadline, std::move(completion));
+}
+inline void GroupDelegate::GetGroupVersionAsync(const domain::Id& tournamentId, const domain::Id& groupId, const deadline::Clock::time_point deadline,
+                                                AsyncCompletion<std::optional<ResourceVersion>> completion) {
+    groupAsyncRepository->FindVersionAsync(tournamentId, groupId, deadline, std::move(completion));
 }
-inline std::expected<void, std::string> GroupDelegate::UpdateGroup(const std::string_view& tournamentId, const domain::Group& group) {
+inline std::expected<void, std::string> GroupDelegate::UpdateGroup(const domain::Id& tournamentId, const domain::Group& group) {
     return std::unexpected("Not implemented");
 }
-inline std::expected<void, std::string> GroupDelegate::RemoveGroup(const std::string_view& tournamentId, const std::string_view& groupId) {
+inline std::expected<void, std::string> GroupDelegate::RemoveGroup(const domain::Id& tournamentId, const domain::Id& groupId) {
     return std::unexpected("Not implemented");
 }
 
-std::expected<void, std::string> GroupDelegate::UpdateTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<domain::Team>& teams) {
-    const auto group = groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId);
-    if (group == nullptr) {
-        return std::unexpected("Group doesn't exist");
-    }
-    if (group->Teams().size() + teams.size() >= 32) {
-        return std::unexpected("Group at max capacity");
+std::expected<void, std::string> GroupDelegate::UpdateTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Team>& teams) {
+    if (teams.empty()) {
+        // nothing to append, the group only has to exist
+        if (groupRepository->FindByTournamentIdAndGroupId(tournamentId, groupId) == nullptr) {
+            return std::unexpected("Group doesn't exist");
+        }
+        return {};
     }
+
+    std::vector<domain::Id> teamIds;
+    teamIds.reserve(teams.size());
     for (const auto& team : teams) {
-        if (const auto groupTeams = groupRepository->FindByTournamentIdAndTeamId(tournamentId, team.Id)) {
+        if (std::ranges::find(teamIds, team.Id) != teamIds.end()) {
             return std::unexpected(std::format("Team {} already exist", team.Id));
         }
+        teamIds.push_back(team.Id);
     }
-    for (const auto& team : teams) {
-        const auto persistedTeam = teamRepository->ReadById(team.Id);
-        if (persistedTeam == nullptr) {
-            return std::unexpected(std::format("Team {} doesn't exist", team.Id));
-        }
-        groupRepository->UpdateGroupAddTeam(groupId, persistedTeam);
-        std::unique_ptr<nlohmann::json> message = std::make_unique<nlohmann::json>();
-        message->emplace("tournamentId", tournamentId);
-        message->emplace("groupId", groupId);
-        message->emplace("teamId", team.Id);
-        messageProducer->SendMessage(message->dump(), "tournament.team-add");
+
+    // one tournament.team-add message per added team is relayed after commit, see OutboxRelay
+    const auto update = groupRepository->AddTeams(tournamentId, groupId, teamIds, "tournament.team-add");
+    switch (update.status) {
+        case GroupTeamsStatus::APPENDED:
+            break;
+        case GroupTeamsStatus::GROUP_NOT_FOUND:
+            return std::unexpected("Group doesn't exist");
+        case GroupTeamsStatus::GROUP_FULL:
+            return std::unexpected("Group at max capacity");
+        case GroupTeamsStatus::DUPLICATED:
+            return std::unexpected(update.duplicatedTeamIds.empty()
+                ? std::string("Team already exist")
+                : std::format("Team {} already exist", update.duplicatedTeamIds.front()));
+        case GroupTeamsStatus::MISSING_TEAM:
+            return std::unexpected(std::format("Team {} doesn't exist", update.missingTeamIds.front()));
     }
+
     return {};
 }
 
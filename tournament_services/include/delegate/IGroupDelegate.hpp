@@ -7,16 +7,24 @@
 #include <expected>
 
 #include "domain/Group.hpp"
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+#include "persistence/repository/IVersionRepository.hpp"
 
 class IGroupDelegate{
 public:
     virtual ~IGroupDelegate() = default;
-    virtual std::expected<std::string, std::string> CreateGroup(const std::string_view& tournamentId, const domain::Group& group) = 0;
-    virtual std::expected<std::vector<std::shared_ptr<domain::Group>>, std::string> GetGroups(const std::string_view& tournamentId) = 0;
-    virtual std::expected<std::shared_ptr<domain::Group>, std::string> GetGroup(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
-    virtual std::expected<void, std::string> UpdateGroup(const std::string_view& tournamentId, const domain::Group& group) = 0;
-    virtual std::expected<void, std::string> RemoveGroup(const std::string_view& tournamentId, const std::string_view& groupId) = 0;
-    virtual std::expected<void, std::string> UpdateTeams(const std::string_view& tournamentId, const std::string_view& groupId, const std::vector<domain::Team>& teams) = 0;
+    virtual std::expected<domain::Id, std::string> CreateGroup(const domain::Id& tournamentId, const domain::Group& group) = 0;
+    virtual void GetGroupsAsync(const domain::Id& tournamentId, deadline::Clock::time_point deadline,
+                                AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion) = 0;
+    virtual void GetGroupAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                               AsyncCompletion<std::shared_ptr<domain::Group>> completion) = 0;
+    // nullopt when the group is not in the tournament
+    virtual void GetGroupVersionAsync(const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                                      AsyncCompletion<std::optional<ResourceVersion>> completion) = 0;
+    virtual std::expected<void, std::string> UpdateGroup(const domain::Id& tournamentId, const domain::Group& group) = 0;
+    virtual std::expected<void, std::string> RemoveGroup(const domain::Id& tournamentId, const domain::Id& groupId) = 0;
+    virtual std::expected<void, std::string> UpdateTeams(const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Team>& teams) = 0;
 };
 
 #endif /* SERVICE_IGROUP_DELEGATE_HPP */
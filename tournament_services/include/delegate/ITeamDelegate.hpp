@@ -1,17 +1,28 @@
 #ifndef ITEAM_DELEGATE_HPP
 #define ITEAM_DELEGATE_HPP
 
-#include <string_view>
 #include <memory>
+#include <optional>
+#include <vector>
 
+#include "domain/Id.hpp"
 #include "domain/Team.hpp"
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+#include "persistence/repository/IVersionRepository.hpp"
+#include "persistence/repository/Page.hpp"
 
 class ITeamDelegate {
     public:
     virtual ~ITeamDelegate() = default;
-    virtual std::shared_ptr<domain::Team> GetTeam(std::string_view id) = 0;
-    virtual std::vector<std::shared_ptr<domain::Team>> GetAllTeams() = 0;
-    virtual std::string_view SaveTeam(const domain::Team& team) = 0;
+    // reads complete from the AsyncQueryExecutor, or right away when the team is cached
+    virtual void GetTeamAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Team>> completion) = 0;
+    // nullopt when the team does not exist
+    virtual void GetTeamVersionAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) = 0;
+    virtual void GetAllTeamsAsync(const PageRequest& page, deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Team>> completion) = 0;
+    virtual domain::Id SaveTeam(const domain::Team& team) = 0;
+    // created ids in input order, nullopt for teams whose name is already taken
+    virtual std::vector<std::optional<domain::Id>> SaveTeams(const std::vector<domain::Team>& teams) = 0;
 };
 
 #endif /* ITEAM_DELEGATE_HPP */
@@ -5,16 +5,22 @@
 #ifndef TOURNAMENTS_ITOURNAMENTDELEGATE_HPP
 #define TOURNAMENTS_ITOURNAMENTDELEGATE_HPP
 
-#include <string>
 #include <memory>
 
+#include "domain/Id.hpp"
 #include "domain/Tournament.hpp"
+#include "persistence/configuration/AsyncResult.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+#include "persistence/repository/IVersionRepository.hpp"
+#include "persistence/repository/Page.hpp"
 
 class ITournamentDelegate {
 public:
     virtual ~ITournamentDelegate() = default;
-    virtual std::string CreateTournament(std::shared_ptr<domain::Tournament> tournament) = 0;
-    virtual std::vector<std::shared_ptr<domain::Tournament>> ReadAll() = 0;
+    virtual domain::Id CreateTournament(std::shared_ptr<domain::Tournament> tournament) = 0;
+    virtual void ReadAllAsync(const PageRequest& page, deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Tournament>> completion) = 0;
+    // version of the whole collection, it validates every page of ReadAllAsync
+    virtual void ReadAllVersionAsync(deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) = 0;
 };
 
 #endif //TOURNAMENTS_ITOURNAMENTDELEGATE_HPP
\ No newline at end of file
@@ -7,16 +7,27 @@
 #include <memory>
 
 #include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/IAsyncRepository.hpp"
+#include "persistence/repository/IAsyncVersionRepository.hpp"
+#include "persistence/repository/IBulkRepository.hpp"
 #include "domain/Team.hpp"
 #include "ITeamDelegate.hpp"
 
 class TeamDelegate : public ITeamDelegate {
-    std::shared_ptr<IRepository<domain::Team, std::string_view>> teamRepository;
+    std::shared_ptr<IRepository<domain::Team, domain::Id>> teamRepository;
+    std::shared_ptr<IBulkRepository<domain::Team>> teamBulkRepository;
+    std::shared_ptr<IAsyncRepository<domain::Team, domain::Id>> teamAsyncRepository;
+    std::shared_ptr<IAsyncVersionRepository<domain::Team>> teamVersionRepository;
     public:
-    explicit TeamDelegate(std::shared_ptr<IRepository<domain::Team, std::string_view>> repository);
-    std::shared_ptr<domain::Team> GetTeam(std::string_view id) override;
-    std::vector<std::shared_ptr<domain::Team>> GetAllTeams() override;
-    std::string_view SaveTeam( const domain::Team& team) override;
+    TeamDelegate(std::shared_ptr<IRepository<domain::Team, domain::Id>> repository,
+                 std::shared_ptr<IBulkRepository<domain::Team>> bulkRepository,
+                 std::shared_ptr<IAsyncRepository<domain::Team, domain::Id>> asyncRepository,
+                 std::shared_ptr<IAsyncVersionRepository<domain::Team>> versionRepository);
+    void GetTeamAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Team>> completion) override;
+    void GetTeamVersionAsync(const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) override;
+    void GetAllTeamsAsync(const PageRequest& page, deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Team>> completion) override;
+    domain::Id SaveTeam( const domain::Team& team) override;
+    std::vector<std::optional<domain::Id>> SaveTeams(const std::vector<domain::Team>& teams) override;
 };
 
 
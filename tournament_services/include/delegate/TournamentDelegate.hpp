@@ -5,20 +5,21 @@
 #ifndef TOURNAMENTS_TOURNAMENTDELEGATE_HPP
 #define TOURNAMENTS_TOURNAMENTDELEGATE_HPP
 
-#include <string>
-
-#include "cms/QueueMessageProducer.hpp"
 #include "delegate/ITournamentDelegate.hpp"
-#include "persistence/repository/IRepository.hpp"
+#include "persistence/repository/IAsyncRepository.hpp"
+#include "persistence/repository/IAsyncVersionRepository.hpp"
+#include "persistence/repository/IOutboxRepository.hpp"
 
 class TournamentDelegate : public ITournamentDelegate{
-    std::shared_ptr<IRepository<domain::Tournament, std::string>> tournamentRepository;
-    std::shared_ptr<QueueMessageProducer> producer;
+    std::shared_ptr<IAsyncRepository<domain::Tournament, domain::Id>> tournamentRepository;
+    std::shared_ptr<IOutboxRepository<domain::Tournament>> outboxRepository;
+    std::shared_ptr<IAsyncVersionRepository<domain::Tournament>> versionRepository;
 public:
-    explicit TournamentDelegate(std::shared_ptr<IRepository<domain::Tournament, std::string>> repository, std::shared_ptr<QueueMessageProducer> producer);
+    explicit TournamentDelegate(std::shared_ptr<IAsyncRepository<domain::Tournament, domain::Id>> repository, std::shared_ptr<IOutboxRepository<domain::Tournament>> outboxRepository, std::shared_ptr<IAsyncVersionRepository<domain::Tournament>> versionRepository);
 
-    std::string CreateTournament(std::shared_ptr<domain::Tournament> tournament) override;
-    std::vector<std::shared_ptr<domain::Tournament>> ReadAll() override;
+    domain::Id CreateTournament(std::shared_ptr<domain::Tournament> tournament) override;
+    void ReadAllAsync(const PageRequest& page, deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Tournament>> completion) override;
+    void ReadAllVersionAsync(deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) override;
 };
 
 #endif //TOURNAMENTS_TOURNAMENTDELEGATE_HPP
\ No newline at end of file
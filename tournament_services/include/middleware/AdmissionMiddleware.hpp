@@ -0,0 +1,241 @@
+#ifndef TOURNAMENTS_ADMISSION_MIDDLEWARE_HPP
+#define TOURNAMENTS_ADMISSION_MIDDLEWARE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <crow.h>
+
+#include "configuration/AdmissionConfiguration.hpp"
+#include "metrics/Metrics.hpp"
+#include "persistence/configuration/RequestDeadline.hpp"
+
+#define RETRY_AFTER_HEADER "Retry-After"
+
+namespace admission {
+    struct LimiterStats {
+        std::atomic<uint64_t> admitted{0};
+        // turned away with 503 because the limit was reached
+        std::atomic<uint64_t> rejected{0};
+        // admitted but answered 503, out of time or out of connections
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    // why the handler gave up, recorded by RouteDefinition in the request's AdmissionMiddleware::context
+    enum class Failure { NONE, POOL_TIMEOUT, DEADLINE_EXCEEDED };
+
+    /**
+     * Adaptive concurrency limit in the spirit of a latency gradient: every sampleWindow requests
+     * the average latency of the window is compared with a slow moving average of past windows.
+     * While recent latency stays within latencyTolerance of it the limit grows by about its square
+     * root, as it rises past that the limit shrinks in proportion, and a window with dropped
+     * requests backs it off outright. Queries then wait in Postgres instead of in the pool, and the
+     * excess is turned away before it takes a worker.
+     */
+    class ConcurrencyLimiter {
+        static constexpr double BACKOFF = 0.9;
+        // windows the long-term latency averages over
+        static constexpr double LONG_WINDOWS = 10;
+
+        config::AdmissionConfiguration configuration;
+        std::atomic<size_t> inflight{0};
+        std::atomic<size_t> limit;
+        LimiterStats stats;
+
+        std::mutex mutex;
+        double estimate;
+        double longLatencyMicros = 0;
+        // completed requests in the window, samples are the ones that were not dropped
+        size_t completions = 0;
+        size_t samples = 0;
+        double latencySumMicros = 0;
+        size_t peakInflight = 0;
+        bool droppedInWindow = false;
+        std::vector<metrics::Sampler> samplers;
+
+        void Update() {
+            if (droppedInWindow) {
+                estimate *= BACKOFF;
+            } else {
+                Adjust();
+            }
+            estimate = std::clamp(estimate, static_cast<double>(configuration.minLimit), static_cast<double>(configuration.maxLimit));
+            limit.store(static_cast<size_t>(estimate), std::memory_order_relaxed);
+
+            completions = 0;
+            samples = 0;
+            latencySumMicros = 0;
+            peakInflight = 0;
+            droppedInWindow = false;
+        }
+
+        void Adjust() {
+            const double shortLatency = latencySumMicros / static_cast<double>(samples);
+            if (longLatencyMicros == 0) {
+                longLatencyMicros = shortLatency;
+            } else {
+                longLatencyMicros += (shortLatency - longLatencyMicros) / LONG_WINDOWS;
+                // after a slow spell the baseline lags behind, let it catch up once latency has recovered
+                if (longLatencyMicros > 2 * shortLatency) {
+                    longLatencyMicros *= 0.95;
+                }
+                // a limit the traffic never came near says nothing about capacity
+                if (static_cast<double>(peakInflight) >= estimate / 2) {
+                    const double gradient = std::clamp(configuration.latencyTolerance * longLatencyMicros / shortLatency, 0.5, 1.0);
+                    const double next = estimate * gradient + std::sqrt(estimate);
+                    estimate = estimate * (1 - configuration.smoothing) + next * configuration.smoothing;
+                }
+            }
+        }
+
+    public:
+        explicit ConcurrencyLimiter(const config::AdmissionConfiguration& configuration)
+            : configuration(configuration),
+              limit(std::clamp(configuration.initialLimit, configuration.minLimit, configuration.maxLimit)),
+              estimate(static_cast<double>(limit.load())) {
+            auto& registry = metrics::Registry::Instance();
+            samplers.push_back(registry.Sample("admission_limit", "Current concurrency limit", metrics::Type::GAUGE, {},
+                [this] { return static_cast<double>(Limit()); }));
+            samplers.push_back(registry.Sample("admission_inflight", "Requests being served", metrics::Type::GAUGE, {},
+                [this] { return static_cast<double>(Inflight()); }));
+            for (const auto& [outcome, counter] : {std::pair{"admitted", &stats.admitted}, {"rejected", &stats.rejected}, {"dropped", &stats.dropped}}) {
+                samplers.push_back(registry.Sample("admission_requests_total", "Requests by admission outcome", metrics::Type::COUNTER, {{"outcome", outcome}},
+                    [counter] { return static_cast<double>(counter->load(std::memory_order_relaxed)); }));
+            }
+        }
+
+        bool TryAcquire() {
+            size_t current = inflight.load(std::memory_order_relaxed);
+            do {
+                if (current >= limit.load(std::memory_order_relaxed)) {
+                    stats.rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            } while (!inflight.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+            stats.admitted.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // dropped requests only count as a backoff signal, their latency is the deadline and not the service's
+        void Release(const std::chrono::steady_clock::duration latency, const bool dropped) {
+            const size_t before = inflight.fetch_sub(1, std::memory_order_relaxed);
+            if (dropped) {
+                stats.dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::lock_guard lock(mutex);
+            peakInflight = std::max(peakInflight, before);
+            if (dropped) {
+                droppedInWindow = true;
+            } else {
+                latencySumMicros += static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+                samples++;
+            }
+            completions++;
+            // with drops in it the window closes after one limit's worth of requests, backing off once per generation
+            const size_t window = droppedInWindow ? std::min(configuration.sampleWindow, Limit()) : configuration.sampleWindow;
+            if (completions >= std::max<size_t>(1, window)) {
+                Update();
+            }
+        }
+
+        [[nodiscard]] size_t Limit() const {
+            return limit.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] size_t Inflight() const {
+            return inflight.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] const LimiterStats& Stats() const {
+            return stats;
+        }
+    };
+}
+
+/**
+ * Crow middleware admitting requests through the ConcurrencyLimiter and giving each admitted one
+ * its deadline: requestTimeout, or less when the client sends deadlineHeader. Requests over the
+ * limit get an immediate 503 with Retry-After, and so do requests that run out of time waiting
+ * for a connection or a query (see RouteDefinition).
+ *
+ * The permit, the deadline and the failure live in the request's context, and after_handle only
+ * runs once the response is ended. A handler that answers later from a database event loop holds
+ * the permit until then and reads its deadline from the context, the thread-local one is only set
+ * for handlers that block on the worker thread.
+ */
+struct AdmissionMiddleware {
+    struct context {
+        bool admitted = false;
+        // the client asked for less than requestTimeout, running out of it says nothing about the server
+        bool shortened = false;
+        std::chrono::steady_clock::time_point started;
+        // time_point::max() for requests that were not admitted
+        deadline::Clock::time_point deadline = deadline::Clock::time_point::max();
+        admission::Failure failure = admission::Failure::NONE;
+    };
+
+    void Configure(const config::AdmissionConfiguration& admissionConfiguration, std::shared_ptr<admission::ConcurrencyLimiter> concurrencyLimiter) {
+        configuration = admissionConfiguration;
+        limiter = std::move(concurrencyLimiter);
+    }
+
+    void before_handle(crow::request& request, crow::response& response, context& ctx) {
+        // never let a deadline outlive the request that set it
+        deadline::Clear();
+        if (!limiter || Exempt(request.url)) {
+            return;
+        }
+        if (!limiter->TryAcquire()) {
+            response.code = crow::SERVICE_UNAVAILABLE;
+            response.add_header(RETRY_AFTER_HEADER, std::to_string(configuration.retryAfter.count()));
+            response.end();
+            return;
+        }
+        ctx.admitted = true;
+        ctx.started = std::chrono::steady_clock::now();
+        const auto timeout = Timeout(request.get_header_value(configuration.deadlineHeader));
+        ctx.shortened = timeout < configuration.requestTimeout;
+        ctx.deadline = ctx.started + timeout;
+        deadline::Set(ctx.deadline);
+    }
+
+    void after_handle(crow::request&, crow::response& response, context& ctx) {
+        deadline::Clear();
+        if (!ctx.admitted) {
+            return;
+        }
+        ctx.admitted = false;
+        // only overload backs the limit off, otherwise any client could shrink it with tiny deadlines
+        const bool dropped = response.code == crow::SERVICE_UNAVAILABLE
+            && (ctx.failure == admission::Failure::POOL_TIMEOUT || (ctx.failure == admission::Failure::DEADLINE_EXCEEDED && !ctx.shortened));
+        limiter->Release(std::chrono::steady_clock::now() - ctx.started, dropped);
+    }
+
+private:
+    config::AdmissionConfiguration configuration;
+    std::shared_ptr<admission::ConcurrencyLimiter> limiter;
+
+    [[nodiscard]] bool Exempt(const std::string& path) const {
+        return std::ranges::any_of(configuration.exemptPaths, [&path](const std::string& prefix) { return path.starts_with(prefix); });
+    }
+
+    // the client may shorten the configured timeout down to minRequestTimeout, anything unparsable or longer is ignored
+    [[nodiscard]] std::chrono::milliseconds Timeout(const std::string& header) const {
+        int64_t millis = 0;
+        if (header.empty() || std::from_chars(header.data(), header.data() + header.size(), millis).ec != std::errc()
+            || millis < 0 || millis >= configuration.requestTimeout.count()) {
+            return configuration.requestTimeout;
+        }
+        return std::clamp(std::chrono::milliseconds(millis), configuration.minRequestTimeout, configuration.requestTimeout);
+    }
+};
+
+#endif //TOURNAMENTS_ADMISSION_MIDDLEWARE_HPP
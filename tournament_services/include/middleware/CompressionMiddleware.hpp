@@ -0,0 +1,254 @@
+#ifndef TOURNAMENTS_COMPRESSION_MIDDLEWARE_HPP
+#define TOURNAMENTS_COMPRESSION_MIDDLEWARE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <crow.h>
+#include <zlib.h>
+#include <zstd.h>
+
+#include "configuration/CompressionConfiguration.hpp"
+
+#define ACCEPT_ENCODING_HEADER "Accept-Encoding"
+#define CONTENT_ENCODING_HEADER "Content-Encoding"
+
+/**
+ * Content coding for response bodies, negotiated from Accept-Encoding. Compressor state lives in
+ * one zlib stream and one zstd context per server thread and is reset between responses instead
+ * of being set up again for each of them.
+ */
+namespace compression {
+    enum class Encoding { IDENTITY, GZIP, ZSTD };
+
+    struct EncodingStats {
+        std::atomic<uint64_t> responses{0};
+        std::atomic<uint64_t> bytesIn{0};
+        std::atomic<uint64_t> bytesOut{0};
+        std::atomic<uint64_t> cpuMicros{0};
+    };
+
+    struct CompressionStats {
+        EncodingStats gzip;
+        EncodingStats zstd;
+        // compressible bodies below minSize
+        std::atomic<uint64_t> belowThreshold{0};
+        // compressible bodies for clients that accept neither coding
+        std::atomic<uint64_t> notAccepted{0};
+    };
+
+    // picks the coding with the highest q value, zstd on a tie; "*" stands for any coding not listed
+    inline Encoding Negotiate(std::string_view acceptEncoding) {
+        static constexpr double UNLISTED = -1;
+        double gzip = UNLISTED, zstd = UNLISTED, any = UNLISTED;
+        while (!acceptEncoding.empty()) {
+            const auto comma = acceptEncoding.find(',');
+            std::string_view item = acceptEncoding.substr(0, comma);
+            acceptEncoding = comma == std::string_view::npos ? std::string_view{} : acceptEncoding.substr(comma + 1);
+
+            double q = 1;
+            if (const auto semicolon = item.find(';'); semicolon != std::string_view::npos) {
+                std::string_view parameter = item.substr(semicolon + 1);
+                item = item.substr(0, semicolon);
+                const auto start = parameter.find_first_not_of(' ');
+                parameter = start == std::string_view::npos ? std::string_view{} : parameter.substr(start);
+                if (parameter.starts_with("q=") || parameter.starts_with("Q=")) {
+                    const auto value = parameter.substr(2);
+                    if (std::from_chars(value.data(), value.data() + value.size(), q).ec != std::errc()) {
+                        q = 0;
+                    }
+                }
+            }
+            const auto first = item.find_first_not_of(' ');
+            if (first == std::string_view::npos) {
+                continue;
+            }
+            item = item.substr(first, item.find_last_not_of(' ') - first + 1);
+            const auto is = [item](const std::string_view coding) {
+                return std::ranges::equal(item, coding, [](const char a, const char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) == b;
+                });
+            };
+            if (is("gzip") || is("x-gzip")) {
+                gzip = q;
+            } else if (is("zstd")) {
+                zstd = q;
+            } else if (item == "*") {
+                any = q;
+            }
+        }
+        if (gzip == UNLISTED) gzip = any;
+        if (zstd == UNLISTED) zstd = any;
+        if (zstd > 0 && zstd >= gzip) {
+            return Encoding::ZSTD;
+        }
+        return gzip > 0 ? Encoding::GZIP : Encoding::IDENTITY;
+    }
+
+    inline bool IsCompressible(const std::string_view contentType) {
+        return contentType.starts_with("application/json") || contentType.starts_with("application/x-ndjson") || contentType.starts_with("text/");
+    }
+
+    // one gzip stream per thread, deflateReset keeps its window and hash tables allocated
+    class GzipCompressor {
+        z_stream stream{};
+        int level = INT_MIN;
+
+        void Init(const int newLevel) {
+            if (level != INT_MIN) {
+                deflateEnd(&stream);
+            }
+            stream = z_stream{};
+            // 16 + 15 bits window asks zlib for the gzip wrapper instead of the zlib one
+            level = deflateInit2(&stream, newLevel, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK ? newLevel : INT_MIN;
+        }
+    public:
+        GzipCompressor() = default;
+        GzipCompressor(const GzipCompressor&) = delete;
+        GzipCompressor& operator=(const GzipCompressor&) = delete;
+        ~GzipCompressor() {
+            if (level != INT_MIN) {
+                deflateEnd(&stream);
+            }
+        }
+
+        bool Compress(const std::string_view input, std::string& output, const int compressionLevel) {
+            if (input.size() > UINT_MAX) {
+                return false;
+            }
+            if (level != compressionLevel) {
+                Init(compressionLevel);
+            } else {
+                deflateReset(&stream);
+            }
+            if (level == INT_MIN) {
+                return false;
+            }
+            int result = Z_STREAM_ERROR;
+            output.resize_and_overwrite(deflateBound(&stream, input.size()), [&](char* buffer, const size_t capacity) {
+                stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+                stream.avail_in = static_cast<uInt>(input.size());
+                stream.next_out = reinterpret_cast<Bytef*>(buffer);
+                stream.avail_out = static_cast<uInt>(capacity);
+                result = deflate(&stream, Z_FINISH);
+                return result == Z_STREAM_END ? static_cast<size_t>(stream.total_out) : 0;
+            });
+            return result == Z_STREAM_END;
+        }
+    };
+
+    // one zstd context per thread, ZSTD_compress2 starts a new frame but keeps the context's buffers
+    class ZstdCompressor {
+        std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+        int level = INT_MIN;
+    public:
+        bool Compress(const std::string_view input, std::string& output, const int compressionLevel) {
+            if (context == nullptr) {
+                return false;
+            }
+            if (level != compressionLevel) {
+                if (ZSTD_isError(ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, compressionLevel))) {
+                    return false;
+                }
+                level = compressionLevel;
+            }
+            size_t written = 0;
+            output.resize_and_overwrite(ZSTD_compressBound(input.size()), [&](char* buffer, const size_t capacity) {
+                written = ZSTD_compress2(context.get(), buffer, capacity, input.data(), input.size());
+                return ZSTD_isError(written) ? 0 : written;
+            });
+            return !ZSTD_isError(written);
+        }
+    };
+
+    inline uint64_t ThreadCpuMicros() {
+        timespec now{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec) / 1000;
+    }
+
+    // compresses input into output with the calling thread's compressor, false leaves the body to go out as it is
+    inline bool Compress(const Encoding encoding, const std::string_view input, std::string& output, const config::CompressionConfiguration& configuration) {
+        thread_local GzipCompressor gzip;
+        thread_local ZstdCompressor zstd;
+        switch (encoding) {
+            case Encoding::GZIP:
+                return gzip.Compress(input, output, configuration.gzipLevel);
+            case Encoding::ZSTD:
+                return zstd.Compress(input, output, configuration.zstdLevel);
+            case Encoding::IDENTITY:
+                break;
+        }
+        return false;
+    }
+}
+
+/**
+ * Crow middleware compressing JSON and NDJSON bodies of at least minSize bytes for clients that
+ * accept gzip or zstd. Every response whose coding depends on Accept-Encoding carries Vary, the
+ * ETags handed out by ConditionalGet are weak so they stay valid across codings.
+ */
+struct CompressionMiddleware {
+    struct context {};
+
+    void Configure(const config::CompressionConfiguration& compressionConfiguration, std::shared_ptr<compression::CompressionStats> compressionStats) {
+        configuration = compressionConfiguration;
+        stats = std::move(compressionStats);
+    }
+
+    void before_handle(crow::request&, crow::response&, context&) {}
+
+    void after_handle(crow::request& request, crow::response& response, context&) {
+        if (response.body.empty() || !response.get_header_value(CONTENT_ENCODING_HEADER).empty()
+            || !compression::IsCompressible(response.get_header_value("content-type"))) {
+            return;
+        }
+        if (response.body.size() < configuration.minSize) {
+            Count(&compression::CompressionStats::belowThreshold);
+            return;
+        }
+        response.add_header("Vary", ACCEPT_ENCODING_HEADER);
+
+        const auto encoding = compression::Negotiate(request.get_header_value(ACCEPT_ENCODING_HEADER));
+        if (encoding == compression::Encoding::IDENTITY) {
+            Count(&compression::CompressionStats::notAccepted);
+            return;
+        }
+
+        const auto started = compression::ThreadCpuMicros();
+        std::string compressed;
+        if (!compression::Compress(encoding, response.body, compressed, configuration) || compressed.size() >= response.body.size()) {
+            return;
+        }
+        const auto cpuMicros = compression::ThreadCpuMicros() - started;
+
+        if (stats) {
+            auto& encodingStats = encoding == compression::Encoding::ZSTD ? stats->zstd : stats->gzip;
+            encodingStats.responses.fetch_add(1, std::memory_order_relaxed);
+            encodingStats.bytesIn.fetch_add(response.body.size(), std::memory_order_relaxed);
+            encodingStats.bytesOut.fetch_add(compressed.size(), std::memory_order_relaxed);
+            encodingStats.cpuMicros.fetch_add(cpuMicros, std::memory_order_relaxed);
+        }
+        response.body = std::move(compressed);
+        response.set_header(CONTENT_ENCODING_HEADER, encoding == compression::Encoding::ZSTD ? "zstd" : "gzip");
+    }
+
+private:
+    config::CompressionConfiguration configuration;
+    std::shared_ptr<compression::CompressionStats> stats;
+
+    void Count(std::atomic<uint64_t> compression::CompressionStats::* counter) const {
+        if (stats) {
+            ((*stats).*counter).fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif //TOURNAMENTS_COMPRESSION_MIDDLEWARE_HPP
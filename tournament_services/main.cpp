@@ -1,23 +1,40 @@
-
 #include <activemq/library/ActiveMQCPP.h>
 
 #include "include/configuration/ContainerSetup.hpp"
 #include "include/configuration/RunConfiguration.hpp"
+#include "configuration/StartupReport.hpp"
 
 int main() {
+    auto& startup = config::StartupReport::Instance();
     activemq::library::ActiveMQCPP::initializeLibrary();
+    // database pools warm up in the background from here on
     const auto container = config::containerSetup();
-    crow::SimpleApp app;
+    startup.Mark("container built");
+    TournamentApp app;
+    app.get_middleware<AdmissionMiddleware>().Configure(
+        *container->resolve<config::AdmissionConfiguration>(),
+        container->resolve<admission::ConcurrencyLimiter>());
+    app.get_middleware<CompressionMiddleware>().Configure(
+        *container->resolve<config::CompressionConfiguration>(),
+        container->resolve<compression::CompressionStats>());
 
     // Bind all annotated routes
     for (auto& def : routeRegistry()) {
         def.binder(app, container);
     }
+    startup.Mark("routes bound");
+
+    // starts the background broker connection, /health reports it, and the outbox relay behind it
+    container->resolve<ConnectionManager>();
+    container->resolve<OutboxRelay>();
 
     auto appConfig = container->resolve<config::RunConfiguration>();
 
-    app.port(appConfig->port)
+    auto server = app.port(appConfig->port)
         .concurrency(appConfig->concurrency)
-        .run();
+        .run_async();
+    app.wait_for_server_start();
+    startup.Mark("listening");
+    server.wait();
     activemq::library::ActiveMQCPP::shutdownLibrary();
 }
@@ -4,53 +4,146 @@
 
 #define JSON_CONTENT_TYPE "application/json"
 #define CONTENT_TYPE_HEADER "content-type"
+#define NDJSON_CONTENT_TYPE "application/x-ndjson"
+#define MAX_BULK_TEAMS 50000
+
+#include <format>
 
 #include "configuration/RouteDefinition.hpp"
 #include "controller/TeamController.hpp"
+#include "controller/ConditionalGet.hpp"
+#include "controller/Pagination.hpp"
+#include "controller/RequestBody.hpp"
+#include "domain/JsonSerializer.hpp"
 #include "domain/Utilities.hpp"
 
 
 TeamController::TeamController(const std::shared_ptr<ITeamDelegate>& teamDelegate) : teamDelegate(teamDelegate) {}
 
-crow::response TeamController::getTeam(const std::string& teamId) const {
-    if(!std::regex_match(teamId, ID_VALUE)) {
-        return crow::response{crow::BAD_REQUEST, "Invalid ID format"};
+void TeamController::getTeam(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply, const std::string& teamId) const {
+    const auto id = domain::Id::Parse(teamId);
+    if(!id) {
+        reply->Send(crow::response{crow::BAD_REQUEST, "Invalid ID format"});
+        return;
     }
 
-    if(auto team = teamDelegate->GetTeam(teamId); team != nullptr) {
-        nlohmann::json body = team;
-        auto response = crow::response{crow::OK, body.dump()};
-        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-        return response;
+    // a conditional request reads the version first, a body that changes in between goes out with an older
+    // validator and is fetched again. Any other takes it from the team, which is cached together with it
+    if (!conditional::HasValidators(request)) {
+        SendTeam(reply, *id, std::nullopt);
+        return;
     }
-    return crow::response{crow::NOT_FOUND, "team not found"};
+    // the request stays alive until the reply is sent
+    teamDelegate->GetTeamVersionAsync(*id, reply->Deadline(), [this, &request, reply, id = *id](auto version) {
+        if (!version) {
+            reply->Fail(version.error());
+        } else if (!*version) {
+            reply->Send(crow::response{crow::NOT_FOUND, "team not found"});
+        } else if (conditional::IsNotModified(request, **version)) {
+            reply->Send(conditional::NotModified(**version));
+        } else {
+            SendTeam(reply, id, *version);
+        }
+    });
 }
 
-crow::response TeamController::getAllTeams() const {
+void TeamController::SendTeam(const std::shared_ptr<IAsyncReply>& reply, const domain::Id& id, const std::optional<ResourceVersion>& version) const {
+    teamDelegate->GetTeamAsync(id, reply->Deadline(), [reply, version](auto team) {
+        if (!team) {
+            reply->Fail(team.error());
+            return;
+        }
+        if (*team == nullptr) {
+            reply->Send(crow::response{crow::NOT_FOUND, "team not found"});
+            return;
+        }
+        auto response = crow::response{crow::OK, domain::ToJson(*team, 128)};
+        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+        conditional::AddValidators(response, version.value_or(ResourceVersion{(*team)->LastModified}));
+        reply->Send(std::move(response));
+    });
+}
 
-    nlohmann::json body = teamDelegate->GetAllTeams();
-    crow::response response{200, body.dump()};
-    response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
-    return response;
+void TeamController::getAllTeams(const crow::request& request, const std::shared_ptr<IAsyncReply>& reply) const {
+    const auto pageRequest = pagination::ParsePageRequest(request);
+    if (!pageRequest) {
+        reply->Send(crow::response{crow::BAD_REQUEST, "Invalid limit or cursor"});
+        return;
+    }
+
+    teamDelegate->GetAllTeamsAsync(*pageRequest, reply->Deadline(), [reply](auto page) {
+        if (!page) {
+            reply->Fail(page.error());
+            return;
+        }
+        crow::response response{200, domain::ToJson(page->items, page->items.size() * 96 + 2)};
+        response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+        pagination::AddNextCursor(response, *page);
+        reply->Send(std::move(response));
+    });
 }
 
 crow::response TeamController::SaveTeam(const crow::request& request) const {
+    const auto team = request_body::ParseTeam(request.body);
+    if (!team) {
+        return crow::response{crow::BAD_REQUEST, team.error()};
+    }
+
     crow::response response;
+    auto createdId = teamDelegate->SaveTeam(*team);
+    response.code = crow::CREATED;
+    response.add_header("location", createdId.ToString());
 
-    if(!nlohmann::json::accept(request.body)) {
-        response.code = crow::BAD_REQUEST;
-        return response;
+    return response;
+}
+
+crow::response TeamController::SaveTeams(const crow::request& request) const {
+    // every item keeps its input position, invalid ones are reported without reaching the database
+    const bool ndjson = request.get_header_value(CONTENT_TYPE_HEADER).starts_with(NDJSON_CONTENT_TYPE);
+    const auto items = request_body::ParseBulkTeams(request.body, ndjson);
+    if (!items) {
+        return crow::response{crow::BAD_REQUEST, items.error()};
     }
-    auto requestBody = nlohmann::json::parse(request.body);
-    domain::Team team = requestBody;
 
-    auto createdId = teamDelegate->SaveTeam(team);
-    response.code = crow::CREATED;
-    response.add_header("location", createdId.data());
+    if (items->empty() || items->size() > MAX_BULK_TEAMS) {
+        return crow::response{crow::BAD_REQUEST, std::format("Expected between 1 and {} teams", MAX_BULK_TEAMS)};
+    }
 
+    std::vector<domain::Team> teams;
+    std::vector<size_t> positions;
+    teams.reserve(items->size());
+    positions.reserve(items->size());
+    for (size_t i = 0; i < items->size(); i++) {
+        if (const auto& item = (*items)[i]) {
+            teams.push_back(domain::Team{{}, item->Name});
+            positions.push_back(i);
+        }
+    }
+
+    const auto ids = teamDelegate->SaveTeams(teams);
+
+    nlohmann::json body = nlohmann::json::array();
+    size_t created = 0;
+    for (size_t i = 0, next = 0; i < items->size(); i++) {
+        if (next < positions.size() && positions[next] == i) {
+            if (next < ids.size() && ids[next].has_value()) {
+                body.push_back({{"id", *ids[next]}});
+                created++;
+            } else {
+                body.push_back({{"error", std::format("Team {} already exist", teams[next].Name)}});
+            }
+            next++;
+        } else {
+            body.push_back({{"error", "Invalid team"}});
+        }
+    }
+
+    crow::response response{created == items->size() ? crow::CREATED : crow::OK, body.dump()};
+    response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
     return response;
 }
 
-REGISTER_ROUTE(TeamController, getTeam, "/teams/<string>", "GET"_method)
-REGISTER_ROUTE(TeamController, getAllTeams, "/teams", "GET"_method)
-REGISTER_ROUTE(TeamController, SaveTeam, "/teams", "POST"_method)
\ No newline at end of file
+REGISTER_ASYNC_ROUTE(TeamController, getTeam, "/teams/<string>", "GET"_method)
+REGISTER_ASYNC_ROUTE(TeamController, getAllTeams, "/teams", "GET"_method)
+REGISTER_ROUTE(TeamController, SaveTeam, "/teams", "POST"_method)
+REGISTER_ROUTE(TeamController, SaveTeams, "/teams/bulk", "POST"_method)
\ No newline at end of file
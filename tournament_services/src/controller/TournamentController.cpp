@@ -7,35 +7,66 @@
 
 #include "configuration/RouteDefinition.hpp"
 #include "controller/TournamentController.hpp"
+#include "controller/ConditionalGet.hpp"
+#include "controller/Pagination.hpp"
+#include "controller/RequestBody.hpp"
 
 #include <string>
 #include <utility>
+#include "domain/JsonSerializer.hpp"
 #include  "domain/Tournament.hpp"
 #include "domain/Utilities.hpp"
 
 TournamentController::TournamentController(std::shared_ptr<ITournamentDelegate> delegate) : tournamentDelegate(std::move(delegate)) {}
 
 crow::response TournamentController::CreateTournament(const crow::request &request) const {
-    nlohmann::json body = nlohmann::json::parse(request.body);
-    const std::shared_ptr<domain::Tournament> tournament = std::make_shared<domain::Tournament>(body);
+    auto parsed = request_body::ParseTournament(request.body);
+    if (!parsed) {
+        return crow::response{crow::BAD_REQUEST, parsed.error()};
+    }
+    const auto tournament = std::make_shared<domain::Tournament>(std::move(*parsed));
 
-    const std::string id = tournamentDelegate->CreateTournament(tournament);
+    const domain::Id id = tournamentDelegate->CreateTournament(tournament);
     crow::response response;
     response.code = crow::CREATED;
-    response.add_header("location", id);
+    response.add_header("location", id.ToString());
     return response;
 }
 
-crow::response TournamentController::ReadAll() const {
-    nlohmann::json body = tournamentDelegate->ReadAll();
-    crow::response response;
-    response.code = crow::OK;
-    response.body = body.dump();
-    response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+void TournamentController::ReadAll(const crow::request &request, const std::shared_ptr<IAsyncReply>& reply) const {
+    const auto pageRequest = pagination::ParsePageRequest(request);
+    if (!pageRequest) {
+        reply->Send(crow::response{crow::BAD_REQUEST, "Invalid limit or cursor"});
+        return;
+    }
 
-    return response;
+    // validators are per URL, so the collection version covers whichever page was asked for. The request stays
+    // alive until the reply is sent
+    tournamentDelegate->ReadAllVersionAsync(reply->Deadline(), [this, &request, reply, pageRequest = *pageRequest](auto version) {
+        if (!version) {
+            reply->Fail(version.error());
+            return;
+        }
+        if (conditional::IsNotModified(request, *version)) {
+            reply->Send(conditional::NotModified(*version));
+            return;
+        }
+        tournamentDelegate->ReadAllAsync(pageRequest, reply->Deadline(), [reply, version = *version](auto page) {
+            if (!page) {
+                reply->Fail(page.error());
+                return;
+            }
+            crow::response response;
+            response.code = crow::OK;
+            response.body = domain::ToJson(page->items, page->items.size() * 160 + 2);
+            response.add_header(CONTENT_TYPE_HEADER, JSON_CONTENT_TYPE);
+            conditional::AddValidators(response, version);
+            pagination::AddNextCursor(response, *page);
+            reply->Send(std::move(response));
+        });
+    });
 }
 
 
 REGISTER_ROUTE(TournamentController, CreateTournament, "/tournaments", "POST"_method)
-REGISTER_ROUTE(TournamentController, ReadAll, "/tournaments", "GET"_method)
\ No newline at end of file
+REGISTER_ASYNC_ROUTE(TournamentController, ReadAll, "/tournaments", "GET"_method)
\ No newline at end of file
@@ -6,20 +6,34 @@
 
 #include <utility>
 
-TeamDelegate::TeamDelegate(std::shared_ptr<IRepository<domain::Team, std::string_view> > repository) : teamRepository(std::move(repository)) {
+TeamDelegate::TeamDelegate(std::shared_ptr<IRepository<domain::Team, domain::Id> > repository,
+                           std::shared_ptr<IBulkRepository<domain::Team> > bulkRepository,
+                           std::shared_ptr<IAsyncRepository<domain::Team, domain::Id> > asyncRepository,
+                           std::shared_ptr<IAsyncVersionRepository<domain::Team> > versionRepository)
+    : teamRepository(std::move(repository)), teamBulkRepository(std::move(bulkRepository)), teamAsyncRepository(std::move(asyncRepository)),
+      teamVersionRepository(std::move(versionRepository)) {
 }
 
-std::vector<std::shared_ptr<domain::Team>> TeamDelegate::GetAllTeams() {
-    return teamRepository->ReadAll();
+void TeamDelegate::GetAllTeamsAsync(const PageRequest& page, const deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Team>> completion) {
+    teamAsyncRepository->ReadPageAsync(page, deadline, std::move(completion));
 }
 
-std::shared_ptr<domain::Team> TeamDelegate::GetTeam(std::string_view id) {
-    return teamRepository->ReadById(id.data());
+void TeamDelegate::GetTeamAsync(const domain::Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Team>> completion) {
+    teamAsyncRepository->ReadByIdAsync(id, deadline, std::move(completion));
 }
 
-std::string_view TeamDelegate::SaveTeam(const domain::Team& team){
+void TeamDelegate::GetTeamVersionAsync(const domain::Id& id, const deadline::Clock::time_point deadline, AsyncCompletion<std::optional<ResourceVersion>> completion) {
+    teamVersionRepository->ReadVersionAsync(id, deadline, std::move(completion));
+}
+
+domain::Id TeamDelegate::SaveTeam(const domain::Team& team){
 
     return teamRepository->Create(team);
 }
 
-
+std::vector<std::optional<domain::Id>> TeamDelegate::SaveTeams(const std::vector<domain::Team>& teams) {
+    if (teams.empty()) {
+        return {};
+    }
+    return teamBulkRepository->CreateAll(teams);
+}
@@ -6,26 +6,29 @@
 
 #include "delegate/TournamentDelegate.hpp"
 
-#include "persistence/repository/IRepository.hpp"
-
-TournamentDelegate::TournamentDelegate(std::shared_ptr<IRepository<domain::Tournament, std::string> > repository, std::shared_ptr<QueueMessageProducer> producer) : tournamentRepository(std::move(repository)), producer(std::move(producer)) {
+TournamentDelegate::TournamentDelegate(std::shared_ptr<IAsyncRepository<domain::Tournament, domain::Id> > repository, std::shared_ptr<IOutboxRepository<domain::Tournament>> outboxRepository, std::shared_ptr<IAsyncVersionRepository<domain::Tournament>> versionRepository)
+    : tournamentRepository(std::move(repository)), outboxRepository(std::move(outboxRepository)), versionRepository(std::move(versionRepository)) {
 }
 
-std::string TournamentDelegate::CreateTournament(std::shared_ptr<domain::Tournament> tournament) {
+domain::Id TournamentDelegate::CreateTournament(std::shared_ptr<domain::Tournament> tournament) {
     //fill groups according to max groups
     std::shared_ptr<domain::Tournament> tp = std::move(tournament);
     // for (auto[i, g] = std::tuple{0, 'A'}; i < tp->Format().NumberOfGroups(); i++,g++) {
     //     tp->Groups().push_back(domain::Group{std::format("Tournament {}", g)});
     // }
 
-    std::string id = tournamentRepository->Create(*tp);
-    producer->SendMessage(id, "tournament.created");
+    // tournament.created is relayed to the broker after commit, see OutboxRelay
+    const domain::Id id = outboxRepository->CreateWithEvent(*tp, "tournament.created");
 
     //if groups are completed also create matches
 
     return id;
 }
 
-std::vector<std::shared_ptr<domain::Tournament> > TournamentDelegate::ReadAll() {
-    return tournamentRepository->ReadAll();
-}
\ No newline at end of file
+void TournamentDelegate::ReadAllAsync(const PageRequest& page, const deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Tournament>> completion) {
+    tournamentRepository->ReadPageAsync(page, deadline, std::move(completion));
+}
+
+void TournamentDelegate::ReadAllVersionAsync(const deadline::Clock::time_point deadline, AsyncCompletion<ResourceVersion> completion) {
+    versionRepository->ReadCollectionVersionAsync(deadline, std::move(completion));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "cache/EntityCache.hpp"
+
+namespace {
+    constexpr domain::Id TEAM_ID = *domain::Id::Parse("3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10");
+    constexpr domain::Id OTHER_TEAM_ID = *domain::Id::Parse("9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384");
+
+    std::shared_ptr<const std::string> Value(const std::string& value) {
+        return std::make_shared<const std::string>(value);
+    }
+
+    domain::Id NumberedId(const uint32_t number) {
+        std::array<uint8_t, 16> bytes{};
+        for (size_t i = 0; i < 4; i++) {
+            bytes[15 - i] = static_cast<uint8_t>(number >> (8 * i));
+        }
+        return domain::Id(bytes);
+    }
+}
+
+TEST(EntityCacheTest, FindReturnsStoredValue) {
+    EntityCache<std::string> cache(100, std::chrono::minutes(1));
+    cache.Put(TEAM_ID, Value("Tigres"));
+
+    const auto found = cache.Find(TEAM_ID);
+
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(*found, "Tigres");
+    EXPECT_EQ(cache.Stats().hits.load(), 1);
+    EXPECT_EQ(cache.Stats().misses.load(), 0);
+}
+
+TEST(EntityCacheTest, MissingKeyCountsAMiss) {
+    EntityCache<std::string> cache(100, std::chrono::minutes(1));
+
+    EXPECT_EQ(cache.Find(TEAM_ID), nullptr);
+    EXPECT_EQ(cache.Stats().misses.load(), 1);
+}
+
+TEST(EntityCacheTest, ExpiredEntryIsNotReturned) {
+    EntityCache<std::string> cache(100, std::chrono::milliseconds(1));
+    cache.Put(TEAM_ID, Value("Tigres"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    EXPECT_EQ(cache.Find(TEAM_ID), nullptr);
+    EXPECT_EQ(cache.Stats().misses.load(), 1);
+}
+
+TEST(EntityCacheTest, PutRefreshesExpiry) {
+    EntityCache<std::string> cache(100, std::chrono::milliseconds(200));
+    cache.Put(TEAM_ID, Value("Tigres"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+
+    cache.Put(TEAM_ID, Value("Pumas"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+
+    // past the first ttl but within the refreshed one
+    const auto found = cache.Find(TEAM_ID);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(*found, "Pumas");
+    EXPECT_EQ(cache.Size(), 1);
+}
+
+TEST(EntityCacheTest, CapacityBoundsTheNumberOfEntries) {
+    // 16 shards with one slot each
+    EntityCache<std::string> cache(16, std::chrono::minutes(1));
+
+    for (uint32_t i = 0; i < 200; i++) {
+        cache.Put(NumberedId(i), Value(std::to_string(i)));
+    }
+
+    EXPECT_LE(cache.Size(), 16);
+    EXPECT_EQ(cache.Stats().evictions.load(), 200 - cache.Size());
+}
+
+TEST(EntityCacheTest, InvalidateRemovesEntry) {
+    EntityCache<std::string> cache(100, std::chrono::minutes(1));
+    cache.Put(TEAM_ID, Value("Tigres"));
+    cache.Put(OTHER_TEAM_ID, Value("Pumas"));
+
+    cache.Invalidate(TEAM_ID);
+
+    EXPECT_EQ(cache.Find(TEAM_ID), nullptr);
+    ASSERT_NE(cache.Find(OTHER_TEAM_ID), nullptr);
+    EXPECT_EQ(cache.Size(), 1);
+}
+
+TEST(EntityCacheTest, InvalidateMissingKeyIsIgnored) {
+    EntityCache<std::string> cache(100, std::chrono::minutes(1));
+
+    cache.Invalidate(TEAM_ID);
+
+    EXPECT_EQ(cache.Size(), 0);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <crow.h>
+
+#include <stdexcept>
+
+#include "configuration/RouteDefinition.hpp"
+
+namespace {
+    struct ThrowingController {
+        void Read(const crow::request&, const std::shared_ptr<IAsyncReply>&) const {
+            throw std::runtime_error("unexpected");
+        }
+    };
+}
+
+class CrowAsyncReplyTest : public ::testing::Test {
+protected:
+    // replies are ended on the connection's io_context, run() stands in for its loop
+    asio::io_context ioContext;
+    crow::request request;
+    crow::response response;
+    AdmissionMiddleware::context admission;
+    std::shared_ptr<RouteMetrics> routeMetrics = std::make_shared<RouteMetrics>("/test/async", crow::HTTPMethod::Get);
+
+    void SetUp() override {
+        request.io_context = &ioContext;
+        admission.deadline = deadline::Clock::now() + std::chrono::seconds(1);
+    }
+
+    std::shared_ptr<CrowAsyncReply> Reply() {
+        return std::make_shared<CrowAsyncReply>(request, response, admission, routeMetrics, "2");
+    }
+};
+
+TEST_F(CrowAsyncReplyTest, SendEndsTheResponseOnTheConnection) {
+    response.add_header("Connection", "Keep-Alive");
+    const auto reply = Reply();
+
+    crow::response sent{crow::OK, "[]"};
+    sent.add_header("content-type", "application/json");
+    reply->Send(std::move(sent));
+    EXPECT_FALSE(response.is_completed());
+    ioContext.run();
+
+    EXPECT_TRUE(response.is_completed());
+    EXPECT_EQ(crow::OK, response.code);
+    EXPECT_EQ("[]", response.body);
+    EXPECT_EQ("application/json", response.get_header_value("content-type"));
+    EXPECT_EQ("Keep-Alive", response.get_header_value("Connection"));
+    EXPECT_EQ(admission::Failure::NONE, admission.failure);
+}
+
+TEST_F(CrowAsyncReplyTest, DeadlineAnswersServiceUnavailable) {
+    const auto reply = Reply();
+    EXPECT_EQ(admission.deadline, reply->Deadline());
+
+    reply->Fail(AsyncError{AsyncError::Kind::DEADLINE, "canceling statement due to statement timeout"});
+    ioContext.run();
+
+    EXPECT_EQ(crow::SERVICE_UNAVAILABLE, response.code);
+    EXPECT_EQ("2", response.get_header_value(RETRY_AFTER_HEADER));
+    EXPECT_EQ(admission::Failure::DEADLINE_EXCEEDED, admission.failure);
+}
+
+TEST_F(CrowAsyncReplyTest, UnavailableCountsAsPoolTimeout) {
+    Reply()->Fail(AsyncError{AsyncError::Kind::UNAVAILABLE, "no database connection available"});
+    ioContext.run();
+
+    EXPECT_EQ(crow::SERVICE_UNAVAILABLE, response.code);
+    EXPECT_EQ(admission::Failure::POOL_TIMEOUT, admission.failure);
+}
+
+TEST_F(CrowAsyncReplyTest, OnlyTheFirstAnswerCounts) {
+    const auto reply = Reply();
+
+    reply->Send(crow::response{crow::NOT_FOUND, "team not found"});
+    reply->Fail(AsyncError{AsyncError::Kind::QUERY, "late failure"});
+    ioContext.run();
+
+    EXPECT_EQ(crow::NOT_FOUND, response.code);
+    EXPECT_EQ("team not found", response.body);
+}
+
+TEST_F(CrowAsyncReplyTest, DroppedReplyAnswersInternalServerError) {
+    Reply().reset();
+    ioContext.run();
+
+    EXPECT_TRUE(response.is_completed());
+    EXPECT_EQ(crow::INTERNAL_SERVER_ERROR, response.code);
+}
+
+TEST_F(CrowAsyncReplyTest, ThrowingControllerAnswersInternalServerError) {
+    const ThrowingController controller;
+
+    handleAsyncRoute(&controller, &ThrowingController::Read, std::shared_ptr<IAsyncReply>(Reply()), request);
+    ioContext.run();
+
+    EXPECT_EQ(crow::INTERNAL_SERVER_ERROR, response.code);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <crow.h>
+
+#include "controller/GroupController.hpp"
+#include "RecordingReply.hpp"
+
+static constexpr std::string_view TOURNAMENT_ID = "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10";
+static constexpr std::string_view GROUP_ID = "9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384";
+
+class GroupDelegateMock : public IGroupDelegate {
+public:
+    MOCK_METHOD((std::expected<domain::Id, std::string>), CreateGroup, (const domain::Id& tournamentId, const domain::Group& group), (override));
+    MOCK_METHOD(void, GetGroupsAsync, (const domain::Id& tournamentId, deadline::Clock::time_point, AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>>), (override));
+    MOCK_METHOD(void, GetGroupAsync, (const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point, AsyncCompletion<std::shared_ptr<domain::Group>>), (override));
+    MOCK_METHOD(void, GetGroupVersionAsync, (const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point, AsyncCompletion<std::optional<ResourceVersion>>), (override));
+    MOCK_METHOD((std::expected<void, std::string>), UpdateGroup, (const domain::Id& tournamentId, const domain::Group& group), (override));
+    MOCK_METHOD((std::expected<void, std::string>), RemoveGroup, (const domain::Id& tournamentId, const domain::Id& groupId), (override));
+    MOCK_METHOD((std::expected<void, std::string>), UpdateTeams, (const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Team>& teams), (override));
+};
+
+class GroupControllerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<GroupDelegateMock> groupDelegateMock;
+    std::shared_ptr<GroupController> groupController;
+
+    void SetUp() override {
+        groupDelegateMock = std::make_shared<GroupDelegateMock>();
+        groupController = std::make_shared<GroupController>(groupDelegateMock);
+    }
+
+    // the mocked delegate completes inline, so the reply is in by the time the route returns
+    std::shared_ptr<RecordingReply> GetGroup(const crow::request& request) const {
+        auto reply = std::make_shared<RecordingReply>();
+        groupController->GetGroup(request, reply, std::string(TOURNAMENT_ID), std::string(GROUP_ID));
+        return reply;
+    }
+};
+
+TEST_F(GroupControllerTest, GetGroup) {
+    auto group = std::make_shared<domain::Group>("Group A", *domain::Id::Parse(GROUP_ID));
+    group->TournamentId() = *domain::Id::Parse(TOURNAMENT_ID);
+    EXPECT_CALL(*groupDelegateMock, GetGroupVersionAsync(testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(std::optional<ResourceVersion>(ResourceVersion{})));
+    EXPECT_CALL(*groupDelegateMock, GetGroupAsync(testing::Eq(*domain::Id::Parse(TOURNAMENT_ID)), testing::Eq(*domain::Id::Parse(GROUP_ID)), testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(group));
+
+    const auto reply = GetGroup(crow::request{});
+
+    ASSERT_TRUE(reply->response.has_value());
+    EXPECT_EQ(crow::OK, reply->response->code);
+    EXPECT_FALSE(reply->response->get_header_value(ETAG_HEADER).empty());
+}
+
+TEST_F(GroupControllerTest, GetGroupNotFound) {
+    EXPECT_CALL(*groupDelegateMock, GetGroupVersionAsync(testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(std::optional<ResourceVersion>{}));
+    EXPECT_CALL(*groupDelegateMock, GetGroupAsync(testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+    const auto reply = GetGroup(crow::request{});
+
+    ASSERT_TRUE(reply->response.has_value());
+    EXPECT_EQ(crow::NOT_FOUND, reply->response->code);
+}
+
+TEST_F(GroupControllerTest, GetGroupDeletedAfterVersionRead) {
+    EXPECT_CALL(*groupDelegateMock, GetGroupVersionAsync(testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(std::optional<ResourceVersion>(ResourceVersion{})));
+    EXPECT_CALL(*groupDelegateMock, GetGroupAsync(testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(std::shared_ptr<domain::Group>{}));
+
+    const auto reply = GetGroup(crow::request{});
+
+    ASSERT_TRUE(reply->response.has_value());
+    EXPECT_EQ(crow::NOT_FOUND, reply->response->code);
+    EXPECT_EQ("group not found", reply->response->body);
+}
+
+TEST_F(GroupControllerTest, GetGroupUnavailable) {
+    EXPECT_CALL(*groupDelegateMock, GetGroupVersionAsync(testing::_, testing::_, testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(std::unexpected(AsyncError{AsyncError::Kind::UNAVAILABLE, "no database connection available"})));
+    EXPECT_CALL(*groupDelegateMock, GetGroupAsync(testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+    const auto reply = GetGroup(crow::request{});
+
+    EXPECT_FALSE(reply->response.has_value());
+    ASSERT_TRUE(reply->failure.has_value());
+    EXPECT_EQ(AsyncError::Kind::UNAVAILABLE, reply->failure->kind);
+}
+
+TEST_F(GroupControllerTest, GetGroups) {
+    auto group = std::make_shared<domain::Group>("Group A", *domain::Id::Parse(GROUP_ID));
+    EXPECT_CALL(*groupDelegateMock, GetGroupsAsync(testing::Eq(*domain::Id::Parse(TOURNAMENT_ID)), testing::_, testing::_))
+        .WillOnce(testing::InvokeArgument<2>(std::vector<std::shared_ptr<domain::Group>>{group}));
+
+    const auto reply = std::make_shared<RecordingReply>();
+    groupController->GetGroups(crow::request{}, reply, std::string(TOURNAMENT_ID));
+
+    ASSERT_TRUE(reply->response.has_value());
+    EXPECT_EQ(crow::OK, reply->response->code);
+    EXPECT_EQ(JSON_CONTENT_TYPE, reply->response->get_header_value(CONTENT_TYPE_HEADER));
+}
@@ -0,0 +1,30 @@
+#ifndef TOURNAMENTS_RECORDING_REPLY_HPP
+#define TOURNAMENTS_RECORDING_REPLY_HPP
+
+#include <optional>
+
+#include "controller/AsyncReply.hpp"
+
+// keeps what an async route answered, the mocked delegates complete inline so it is there once the call returns
+class RecordingReply : public IAsyncReply {
+public:
+    deadline::Clock::time_point deadline = deadline::Clock::now() + std::chrono::seconds(5);
+    std::optional<crow::response> response;
+    std::optional<AsyncError> failure;
+
+    [[nodiscard]] deadline::Clock::time_point Deadline() const override {
+        return deadline;
+    }
+    void Send(crow::response sent) override {
+        if (!response && !failure) {
+            response = std::move(sent);
+        }
+    }
+    void Fail(const AsyncError& error) override {
+        if (!response && !failure) {
+            failure = error;
+        }
+    }
+};
+
+#endif //TOURNAMENTS_RECORDING_REPLY_HPP
@@ -5,12 +5,19 @@
 #include "domain/Team.hpp"
 #include "delegate/ITeamDelegate.hpp"
 #include "controller/TeamController.hpp"
+#include "controller/ConditionalGet.hpp"
+#include "RecordingReply.hpp"
+
+static constexpr std::string_view TEAM_ID = "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10";
+static constexpr std::string_view NEW_TEAM_ID = "9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384";
 
 class TeamDelegateMock : public ITeamDelegate {
     public:
-    MOCK_METHOD(std::shared_ptr<domain::Team>, GetTeam, (const std::string_view id), (override));
-    MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, GetAllTeams, (), (override));
-    MOCK_METHOD(std::string_view, SaveTeam, (const domain::Team&), (override));
+    MOCK_METHOD(void, GetTeamAsync, (const domain::Id& id, deadline::Clock::time_point, AsyncCompletion<std::shared_ptr<domain::Team>>), (override));
+    MOCK_METHOD(void, GetTeamVersionAsync, (const domain::Id& id, deadline::Clock::time_point, AsyncCompletion<std::optional<ResourceVersion>>), (override));
+    MOCK_METHOD(void, GetAllTeamsAsync, (const PageRequest&, deadline::Clock::time_point, AsyncCompletion<Page<domain::Team>>), (override));
+    MOCK_METHOD(domain::Id, SaveTeam, (const domain::Team&), (override));
+    MOCK_METHOD(std::vector<std::optional<domain::Id>>, SaveTeams, (const std::vector<domain::Team>&), (override));
 };
 
 class TeamControllerTest : public ::testing::Test{
@@ -28,51 +35,122 @@ protected:
         // teardown code comes here
     }
 
+    // the mocked delegate completes inline, so the reply is in by the time the route returns
+    static crow::response Answer(const std::shared_ptr<RecordingReply>& reply) {
+        EXPECT_TRUE(reply->response.has_value());
+        return reply->response ? std::move(*reply->response) : crow::response{};
+    }
+
+    crow::response GetTeam(const crow::request& request, const std::string& teamId) const {
+        const auto reply = std::make_shared<RecordingReply>();
+        teamController->getTeam(request, reply, teamId);
+        return Answer(reply);
+    }
+
+    crow::response GetAllTeams(const crow::request& request) const {
+        const auto reply = std::make_shared<RecordingReply>();
+        teamController->getAllTeams(request, reply);
+        return Answer(reply);
+    }
+
 };
 
 TEST_F(TeamControllerTest, GetTeamById_ErrorFormat) {
-    crow::response badRequest = teamController->getTeam("");
+    crow::request request;
+    crow::response badRequest = GetTeam(request, "");
 
     EXPECT_EQ(badRequest.code, crow::BAD_REQUEST);
 
-    badRequest = teamController->getTeam("mfasd#*");
+    badRequest = GetTeam(request, "mfasd#*");
+    EXPECT_EQ(badRequest.code, crow::BAD_REQUEST);
+
+    badRequest = GetTeam(request, "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c1g");
     EXPECT_EQ(badRequest.code, crow::BAD_REQUEST);
 }
 
 TEST_F(TeamControllerTest, GetTeamById) {
 
-    std::shared_ptr<domain::Team> expectedTeam = std::make_shared<domain::Team>(domain::Team{"my-id",  "Team Name"});
+    const auto id = *domain::Id::Parse(TEAM_ID);
+    std::shared_ptr<domain::Team> expectedTeam = std::make_shared<domain::Team>(
+        domain::Team{id,  "Team Name", std::chrono::sys_time<std::chrono::microseconds>(std::chrono::seconds(1760000000))});
 
-    EXPECT_CALL(*teamDelegateMock, GetTeam(testing::Eq(std::string("my-id"))))
-        .WillOnce(testing::Return(expectedTeam));
+    // without validators in the request the version comes with the team
+    EXPECT_CALL(*teamDelegateMock, GetTeamVersionAsync(::testing::_, ::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*teamDelegateMock, GetTeamAsync(testing::Eq(id), ::testing::_, ::testing::_))
+        .WillOnce(testing::InvokeArgument<2>(expectedTeam));
 
-    crow::response response = teamController->getTeam("my-id");
+    crow::request request;
+    crow::response response = GetTeam(request, std::string(TEAM_ID));
     auto jsonResponse = crow::json::load(response.body);
 
     EXPECT_EQ(crow::OK, response.code);
-    EXPECT_EQ(expectedTeam->Id, jsonResponse["id"]);
+    EXPECT_EQ(std::string(TEAM_ID), jsonResponse["id"]);
     EXPECT_EQ(expectedTeam->Name, jsonResponse["name"]);
+    EXPECT_EQ(conditional::ETag(ResourceVersion{expectedTeam->LastModified}), response.get_header_value("ETag"));
+    EXPECT_EQ("Thu, 09 Oct 2025 08:53:20 GMT", response.get_header_value("Last-Modified"));
 }
 
 TEST_F(TeamControllerTest, GetTeamNotFound) {
-    EXPECT_CALL(*teamDelegateMock, GetTeam(testing::Eq(std::string("my-id"))))
-        .WillOnce(testing::Return(nullptr));
+    EXPECT_CALL(*teamDelegateMock, GetTeamAsync(testing::Eq(*domain::Id::Parse(TEAM_ID)), ::testing::_, ::testing::_))
+        .WillOnce(testing::InvokeArgument<2>(std::shared_ptr<domain::Team>{}));
+
+    crow::request request;
+    crow::response response = GetTeam(request, std::string(TEAM_ID));
+
+    EXPECT_EQ(crow::NOT_FOUND, response.code);
+}
 
-    crow::response response = teamController->getTeam("my-id");
+TEST_F(TeamControllerTest, GetTeamNotFoundWithValidators) {
+    EXPECT_CALL(*teamDelegateMock, GetTeamVersionAsync(testing::Eq(*domain::Id::Parse(TEAM_ID)), ::testing::_, ::testing::_))
+        .WillOnce(testing::InvokeArgument<2>(std::optional<ResourceVersion>{}));
+    EXPECT_CALL(*teamDelegateMock, GetTeamAsync(::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    crow::request request;
+    request.add_header("If-None-Match", "\"other\"");
+    crow::response response = GetTeam(request, std::string(TEAM_ID));
 
     EXPECT_EQ(crow::NOT_FOUND, response.code);
 }
 
+TEST_F(TeamControllerTest, GetTeamNotModified) {
+    const ResourceVersion version{std::chrono::sys_time<std::chrono::microseconds>(std::chrono::seconds(1760000000)), 1};
+    EXPECT_CALL(*teamDelegateMock, GetTeamVersionAsync(testing::Eq(*domain::Id::Parse(TEAM_ID)), ::testing::_, ::testing::_))
+        .WillRepeatedly(testing::InvokeArgument<2>(std::optional<ResourceVersion>(version)));
+    EXPECT_CALL(*teamDelegateMock, GetTeamAsync(::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    crow::request request;
+    request.add_header("If-None-Match", "\"other\", " + conditional::ETag(version));
+    EXPECT_EQ(crow::NOT_MODIFIED, GetTeam(request, std::string(TEAM_ID)).code);
+
+    crow::request sinceRequest;
+    sinceRequest.add_header("If-Modified-Since", conditional::HttpDate(std::chrono::sys_seconds(std::chrono::seconds(1760000000))));
+    EXPECT_EQ(crow::NOT_MODIFIED, GetTeam(sinceRequest, std::string(TEAM_ID)).code);
+}
+
+TEST_F(TeamControllerTest, GetTeamFailureReachesTheReply) {
+    const auto deadline = deadline::Clock::now() + std::chrono::milliseconds(250);
+    EXPECT_CALL(*teamDelegateMock, GetTeamAsync(testing::Eq(*domain::Id::Parse(TEAM_ID)), testing::Eq(deadline), ::testing::_))
+        .WillOnce(testing::InvokeArgument<2>(std::unexpected(AsyncError{AsyncError::Kind::DEADLINE, "canceling statement"})));
+
+    const auto reply = std::make_shared<RecordingReply>();
+    reply->deadline = deadline;
+    teamController->getTeam(crow::request{}, reply, std::string(TEAM_ID));
+
+    EXPECT_FALSE(reply->response.has_value());
+    ASSERT_TRUE(reply->failure.has_value());
+    EXPECT_EQ(AsyncError::Kind::DEADLINE, reply->failure->kind);
+}
+
 TEST_F(TeamControllerTest, SaveTeamTest) {
     domain::Team capturedTeam;
     EXPECT_CALL(*teamDelegateMock, SaveTeam(::testing::_))
         .WillOnce(testing::DoAll(
                 testing::SaveArg<0>(&capturedTeam),
-                testing::Return("new-id")
+                testing::Return(*domain::Id::Parse(NEW_TEAM_ID))
             )
         );
 
-    nlohmann::json teamRequestBody = {{"id", "new-id"}, {"name", "new team"}};
+    nlohmann::json teamRequestBody = {{"id", NEW_TEAM_ID}, {"name", "new team"}};
     crow::request teamRequest;
     teamRequest.body = teamRequestBody.dump();
 
@@ -81,6 +159,96 @@ TEST_F(TeamControllerTest, SaveTeamTest) {
     testing::Mock::VerifyAndClearExpectations(&teamDelegateMock);
 
     EXPECT_EQ(crow::CREATED, response.code);
-    EXPECT_EQ(teamRequestBody.at("id").get<std::string>(), capturedTeam.Id);
+    EXPECT_EQ(NEW_TEAM_ID, response.get_header_value("location"));
+    EXPECT_EQ(NEW_TEAM_ID, capturedTeam.Id.ToString());
     EXPECT_EQ(teamRequestBody.at("name").get<std::string>(), capturedTeam.Name);
-}
\ No newline at end of file
+}
+
+TEST_F(TeamControllerTest, SaveTeam_InvalidBody) {
+    EXPECT_CALL(*teamDelegateMock, SaveTeam(::testing::_)).Times(0);
+    crow::request request;
+
+    request.body = R"({"name": "unterminated")";
+    EXPECT_EQ(crow::BAD_REQUEST, teamController->SaveTeam(request).code);
+
+    request.body = R"({"id": "no-name"})";
+    crow::response response = teamController->SaveTeam(request);
+    EXPECT_EQ(crow::BAD_REQUEST, response.code);
+    EXPECT_EQ("name: required", response.body);
+
+    request.body = R"({"name": 42})";
+    response = teamController->SaveTeam(request);
+    EXPECT_EQ(crow::BAD_REQUEST, response.code);
+    EXPECT_EQ("name: expected a string", response.body);
+
+    request.body = R"({"id": "my-id", "name": "bad id"})";
+    response = teamController->SaveTeam(request);
+    EXPECT_EQ(crow::BAD_REQUEST, response.code);
+    EXPECT_EQ("id: expected a UUID", response.body);
+}
+
+TEST_F(TeamControllerTest, GetAllTeams_NextCursor) {
+    Page<domain::Team> page;
+    page.items.push_back(std::make_shared<domain::Team>(domain::Team{*domain::Id::Parse(TEAM_ID), "Team Name"}));
+    page.next = KeysetPosition{"2025-10-19 19:21:56.384123", std::string(TEAM_ID)};
+    PageRequest capturedPage;
+    EXPECT_CALL(*teamDelegateMock, GetAllTeamsAsync(::testing::_, ::testing::_, ::testing::_))
+        .WillOnce(testing::DoAll(
+                testing::SaveArg<0>(&capturedPage),
+                testing::InvokeArgument<2>(page)
+            )
+        );
+
+    crow::request request;
+    request.url_params = crow::query_string("/teams?limit=1");
+    crow::response response = GetAllTeams(request);
+
+    EXPECT_EQ(crow::OK, response.code);
+    EXPECT_EQ(1, capturedPage.limit);
+    EXPECT_FALSE(capturedPage.after.has_value());
+    EXPECT_EQ(cursor::Encode(*page.next), response.get_header_value("x-next-cursor"));
+}
+
+TEST_F(TeamControllerTest, GetAllTeams_InvalidPage) {
+    crow::request request;
+    request.url_params = crow::query_string("/teams?limit=0");
+    EXPECT_EQ(crow::BAD_REQUEST, GetAllTeams(request).code);
+
+    request.url_params = crow::query_string("/teams?cursor=not*a*cursor");
+    EXPECT_EQ(crow::BAD_REQUEST, GetAllTeams(request).code);
+}
+
+TEST_F(TeamControllerTest, SaveTeams_Ndjson) {
+    std::vector<domain::Team> capturedTeams;
+    EXPECT_CALL(*teamDelegateMock, SaveTeams(::testing::_))
+        .WillOnce(testing::DoAll(
+                testing::SaveArg<0>(&capturedTeams),
+                testing::Return(std::vector<std::optional<domain::Id>>{domain::Id::Parse(NEW_TEAM_ID), std::nullopt})
+            )
+        );
+
+    crow::request request;
+    request.add_header("content-type", "application/x-ndjson");
+    request.body = "{\"name\": \"team 1\"}\n{\"id\": \"no-name\"}\n\n{\"name\": \"team 2\"}\n";
+
+    crow::response response = teamController->SaveTeams(request);
+    auto jsonResponse = nlohmann::json::parse(response.body);
+
+    EXPECT_EQ(crow::OK, response.code);
+    ASSERT_EQ(2, capturedTeams.size());
+    EXPECT_EQ("team 1", capturedTeams[0].Name);
+    EXPECT_EQ("team 2", capturedTeams[1].Name);
+    ASSERT_EQ(3, jsonResponse.size());
+    EXPECT_EQ(NEW_TEAM_ID, jsonResponse[0]["id"].get<std::string>());
+    EXPECT_TRUE(jsonResponse[1].contains("error"));
+    EXPECT_EQ("Team team 2 already exist", jsonResponse[2]["error"].get<std::string>());
+}
+
+TEST_F(TeamControllerTest, SaveTeams_InvalidBody) {
+    crow::request request;
+    request.body = R"({"name": "not an array"})";
+    EXPECT_EQ(crow::BAD_REQUEST, teamController->SaveTeams(request).code);
+
+    request.body = "[]";
+    EXPECT_EQ(crow::BAD_REQUEST, teamController->SaveTeams(request).code);
+}
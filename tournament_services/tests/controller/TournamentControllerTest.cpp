@@ -1,16 +1,17 @@
 #include <gtest/gtest.h>
 #include "domain/Team.hpp"
 #include "controller/TournamentController.hpp"
+#include "RecordingReply.hpp"
 
 
 TEST(TournamentControllerTest, CreateTournament) {
     std::shared_ptr<TournamentController> tournamentController;
-    tournamentController->ReadAll();
-    std::string id = "ID";
+    tournamentController->ReadAll(crow::request{}, std::make_shared<RecordingReply>());
+    std::string id = "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10";
     std::string name = "Name";
 
-    domain::Team team = {id,name};
+    domain::Team team = {*domain::Id::Parse(id),name};
 
-    EXPECT_EQ(team.Id.c_str(), id);
+    EXPECT_EQ(team.Id.ToString(), id);
     EXPECT_EQ(team.Name.c_str(), name);
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "delegate/GroupDelegate.hpp"
+
+namespace {
+    constexpr domain::Id TOURNAMENT_ID = *domain::Id::Parse("3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10");
+    constexpr domain::Id GROUP_ID = *domain::Id::Parse("9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384");
+
+    template<typename Type>
+    std::expected<Type, AsyncError> Failure(const AsyncError::Kind kind, const std::string& message) {
+        return std::unexpected(AsyncError{kind, message});
+    }
+}
+
+class GroupRepositoryMock : public IGroupRepository {
+public:
+    MOCK_METHOD(std::shared_ptr<domain::Group>, ReadById, (domain::Id id), (override));
+    MOCK_METHOD(domain::Id, Create, (const domain::Group& entity), (override));
+    MOCK_METHOD(domain::Id, Update, (const domain::Group& entity), (override));
+    MOCK_METHOD(void, Delete, (domain::Id id), (override));
+    MOCK_METHOD(std::vector<std::shared_ptr<domain::Group>>, ReadAll, (), (override));
+    MOCK_METHOD(Page<domain::Group>, ReadPage, (const PageRequest& request), (override));
+    MOCK_METHOD(std::vector<std::shared_ptr<domain::Group>>, FindByTournamentId, (const domain::Id& tournamentId), (override));
+    MOCK_METHOD(std::shared_ptr<domain::Group>, FindByTournamentIdAndGroupId, (const domain::Id& tournamentId, const domain::Id& groupId), (override));
+    MOCK_METHOD(std::optional<ResourceVersion>, FindVersion, (const domain::Id& tournamentId, const domain::Id& groupId), (override));
+    MOCK_METHOD(std::shared_ptr<domain::Group>, FindByTournamentIdAndTeamId, (const domain::Id& tournamentId, const domain::Id& teamId), (override));
+    MOCK_METHOD(GroupTeamsUpdate, AddTeams, (const domain::Id& tournamentId, const domain::Id& groupId, const std::vector<domain::Id>& teamIds, std::string_view eventQueue), (override));
+    MOCK_METHOD(bool, IsTeamInTournament, (const domain::Id& tournamentId, const domain::Id& teamId), (override));
+    MOCK_METHOD(std::optional<domain::Id>, FindGroupIdByTeamId, (const domain::Id& tournamentId, const domain::Id& teamId), (override));
+    MOCK_METHOD(size_t, CountTeamsInGroup, (const domain::Id& groupId), (override));
+};
+
+class AsyncGroupRepositoryMock : public IAsyncGroupRepository {
+public:
+    MOCK_METHOD(void, FindByTournamentIdAsync, (const domain::Id& tournamentId, deadline::Clock::time_point deadline,
+                AsyncCompletion<std::vector<std::shared_ptr<domain::Group>>> completion), (override));
+    MOCK_METHOD(void, FindByTournamentIdAndGroupIdAsync, (const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                AsyncCompletion<std::shared_ptr<domain::Group>> completion), (override));
+    MOCK_METHOD(void, FindVersionAsync, (const domain::Id& tournamentId, const domain::Id& groupId, deadline::Clock::time_point deadline,
+                AsyncCompletion<std::optional<ResourceVersion>> completion), (override));
+};
+
+class GroupDelegateTest : public ::testing::Test {
+protected:
+    std::shared_ptr<GroupRepositoryMock> groupRepositoryMock;
+    std::shared_ptr<AsyncGroupRepositoryMock> asyncGroupRepositoryMock;
+    std::shared_ptr<GroupDelegate> groupDelegate;
+    const deadline::Clock::time_point deadline = deadline::Clock::now() + std::chrono::seconds(1);
+
+    void SetUp() override {
+        groupRepositoryMock = std::make_shared<GroupRepositoryMock>();
+        asyncGroupRepositoryMock = std::make_shared<AsyncGroupRepositoryMock>();
+        groupDelegate = std::make_shared<GroupDelegate>(nullptr, groupRepositoryMock, asyncGroupRepositoryMock, nullptr);
+    }
+};
+
+TEST_F(GroupDelegateTest, GetGroupQueryErrorIsReported) {
+    EXPECT_CALL(*asyncGroupRepositoryMock, FindByTournamentIdAndGroupIdAsync(TOURNAMENT_ID, GROUP_ID, deadline, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(Failure<std::shared_ptr<domain::Group>>(AsyncError::Kind::QUERY, "relation does not exist")));
+
+    std::optional<std::expected<std::shared_ptr<domain::Group>, AsyncError>> group;
+    groupDelegate->GetGroupAsync(TOURNAMENT_ID, GROUP_ID, deadline, [&group](auto result) { group = std::move(result); });
+
+    ASSERT_TRUE(group.has_value());
+    ASSERT_FALSE(group->has_value());
+    EXPECT_EQ(AsyncError::Kind::QUERY, group->error().kind);
+    EXPECT_EQ("relation does not exist", group->error().message);
+}
+
+TEST_F(GroupDelegateTest, GetGroupLetsUnavailableThrough) {
+    EXPECT_CALL(*asyncGroupRepositoryMock, FindByTournamentIdAndGroupIdAsync(TOURNAMENT_ID, GROUP_ID, deadline, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(Failure<std::shared_ptr<domain::Group>>(AsyncError::Kind::UNAVAILABLE, "no connection")));
+
+    std::optional<std::expected<std::shared_ptr<domain::Group>, AsyncError>> group;
+    groupDelegate->GetGroupAsync(TOURNAMENT_ID, GROUP_ID, deadline, [&group](auto result) { group = std::move(result); });
+
+    ASSERT_TRUE(group.has_value());
+    ASSERT_FALSE(group->has_value());
+    EXPECT_EQ(AsyncError::Kind::UNAVAILABLE, group->error().kind);
+}
+
+TEST_F(GroupDelegateTest, GetGroupsLetsDeadlineThrough) {
+    EXPECT_CALL(*asyncGroupRepositoryMock, FindByTournamentIdAsync(TOURNAMENT_ID, deadline, testing::_))
+        .WillOnce(testing::InvokeArgument<2>(Failure<std::vector<std::shared_ptr<domain::Group>>>(AsyncError::Kind::DEADLINE, "late")));
+
+    std::optional<std::expected<std::vector<std::shared_ptr<domain::Group>>, AsyncError>> groups;
+    groupDelegate->GetGroupsAsync(TOURNAMENT_ID, deadline, [&groups](auto result) { groups = std::move(result); });
+
+    ASSERT_TRUE(groups.has_value());
+    ASSERT_FALSE(groups->has_value());
+    EXPECT_EQ(AsyncError::Kind::DEADLINE, groups->error().kind);
+}
+
+TEST_F(GroupDelegateTest, GetGroupVersionLetsDeadlineThrough) {
+    EXPECT_CALL(*asyncGroupRepositoryMock, FindVersionAsync(TOURNAMENT_ID, GROUP_ID, deadline, testing::_))
+        .WillOnce(testing::InvokeArgument<3>(Failure<std::optional<ResourceVersion>>(AsyncError::Kind::DEADLINE, "late")));
+
+    std::optional<std::expected<std::optional<ResourceVersion>, AsyncError>> version;
+    groupDelegate->GetGroupVersionAsync(TOURNAMENT_ID, GROUP_ID, deadline, [&version](auto result) { version = std::move(result); });
+
+    ASSERT_TRUE(version.has_value());
+    ASSERT_FALSE(version->has_value());
+    EXPECT_EQ(AsyncError::Kind::DEADLINE, version->error().kind);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "domain/JsonSerializer.hpp"
+#include "domain/Utilities.hpp"
+
+namespace {
+    constexpr domain::Id TEAM_ID = *domain::Id::Parse("3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10");
+    constexpr domain::Id TOURNAMENT_ID = *domain::Id::Parse("9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384");
+    constexpr domain::Id GROUP_ID = *domain::Id::Parse("5d8a0f13-c2e9-47b6-8a1f-e03c95b7d246");
+}
+
+TEST(JsonSerializerTest, TeamMatchesNlohmann) {
+    const auto team = std::make_shared<domain::Team>(domain::Team{TEAM_ID, "Team \"Name\"\n"});
+
+    EXPECT_EQ(nlohmann::json(team).dump(), domain::ToJson(team));
+    EXPECT_EQ(R"({"id":"3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10","name":"Team \"Name\"\n"})", domain::ToJson(team));
+}
+
+TEST(JsonSerializerTest, TournamentMatchesNlohmann) {
+    auto tournament = std::make_shared<domain::Tournament>("Copa \xC3\xA9", domain::TournamentFormat(4, 8, domain::TournamentType::NFL));
+    tournament->Id() = TOURNAMENT_ID;
+    const std::vector tournaments{tournament};
+
+    EXPECT_EQ(nlohmann::json(tournaments).dump(), domain::ToJson(tournaments));
+}
+
+TEST(JsonSerializerTest, GroupMatchesNlohmann) {
+    auto group = std::make_shared<domain::Group>("Group A", GROUP_ID);
+    group->TournamentId() = TOURNAMENT_ID;
+    group->Teams().push_back(domain::Team{TEAM_ID, "Team 1"});
+    group->Teams().push_back(domain::Team{TOURNAMENT_ID, "Tab\tTeam\x01"});
+    const std::vector groups{group};
+
+    EXPECT_EQ(nlohmann::json(groups).dump(), domain::ToJson(groups));
+    EXPECT_EQ(nlohmann::json(*group).dump(), domain::ToJson(*group));
+}
+
+TEST(JsonSerializerTest, EmptyIdIsOmitted) {
+    const auto team = std::make_shared<domain::Team>(domain::Team{{}, "No Id"});
+
+    EXPECT_EQ(R"({"name":"No Id"})", domain::ToJson(team));
+    EXPECT_EQ("[]", domain::ToJson(std::vector<std::shared_ptr<domain::Team>>{}));
+}
+
+TEST(JsonSerializerTest, OpenMatchMatchesNlohmann) {
+    domain::Match match;
+    match.TournamentId() = TOURNAMENT_ID;
+    match.HomeTeamId() = TEAM_ID;
+    match.Round() = 2;
+
+    // the stored document goes through to_json, an open match has no visitor and a new one no id
+    EXPECT_EQ(nlohmann::json(match).dump(), domain::ToJson(match));
+    EXPECT_EQ(R"({"homeTeamId":"3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10","round":2,"score":{"homeTeamScore":0,"visitorTeamScore":0},"tournamentId":"9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384"})",
+        domain::ToJson(match));
+}
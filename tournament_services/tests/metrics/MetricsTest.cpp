@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "metrics/Metrics.hpp"
+
+TEST(MetricsTest, CounterAddsUpEveryThread) {
+    auto& counter = metrics::Registry::Instance().GetCounter("test_counter_total", "Test counter", {{"case", "threads"}});
+
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < 1000; j++) {
+                counter.Increment();
+            }
+        });
+    }
+    threads.clear();
+
+    EXPECT_EQ(8000, counter.Value());
+}
+
+TEST(MetricsTest, SameNameAndLabelsIsTheSameSeries) {
+    auto& registry = metrics::Registry::Instance();
+    auto& first = registry.GetCounter("test_shared_total", "Test counter", {{"case", "a"}});
+    auto& again = registry.GetCounter("test_shared_total", "Test counter", {{"case", "a"}});
+    auto& other = registry.GetCounter("test_shared_total", "Test counter", {{"case", "b"}});
+
+    EXPECT_EQ(&first, &again);
+    EXPECT_NE(&first, &other);
+}
+
+TEST(MetricsTest, HistogramPlacesObservationsInTheirBucket) {
+    metrics::Histogram histogram;
+    histogram.Observe(std::chrono::microseconds(50));
+    histogram.Observe(std::chrono::microseconds(100));
+    histogram.Observe(std::chrono::milliseconds(3));
+    histogram.Observe(std::chrono::seconds(30));
+
+    const auto snapshot = histogram.Read();
+    EXPECT_EQ(4, snapshot.count);
+    // a bound is inclusive
+    EXPECT_EQ(2, snapshot.buckets[0]);
+    // 2.5ms < 3ms <= 5ms
+    EXPECT_EQ(1, snapshot.buckets[5]);
+    EXPECT_EQ(1, snapshot.buckets.back());
+    EXPECT_EQ(30'003'150'000, snapshot.sumNanos);
+}
+
+TEST(MetricsTest, RenderWritesCumulativeBuckets) {
+    auto& histogram = metrics::Registry::Instance().GetHistogram("test_render_seconds", "Test histogram", {{"route", "/a\"b"}});
+    histogram.Observe(std::chrono::microseconds(50));
+    histogram.Observe(std::chrono::seconds(30));
+
+    const std::string text = metrics::Registry::Instance().Render();
+
+    EXPECT_NE(std::string::npos, text.find("# TYPE test_render_seconds histogram\n"));
+    EXPECT_NE(std::string::npos, text.find("test_render_seconds_bucket{route=\"/a\\\"b\",le=\"0.0001\"} 1\n"));
+    EXPECT_NE(std::string::npos, text.find("test_render_seconds_bucket{route=\"/a\\\"b\",le=\"10\"} 1\n"));
+    EXPECT_NE(std::string::npos, text.find("test_render_seconds_bucket{route=\"/a\\\"b\",le=\"+Inf\"} 2\n"));
+    EXPECT_NE(std::string::npos, text.find("test_render_seconds_count{route=\"/a\\\"b\"} 2\n"));
+}
+
+TEST(MetricsTest, SamplerIsReadOnScrapeAndRemovedWithItsOwner) {
+    double level = 3;
+    {
+        const auto sampler = metrics::Registry::Instance().Sample("test_level", "Test gauge", metrics::Type::GAUGE, {},
+            [&level] { return level; });
+        level = 7;
+        EXPECT_NE(std::string::npos, metrics::Registry::Instance().Render().find("test_level 7"));
+    }
+
+    const std::string text = metrics::Registry::Instance().Render();
+    EXPECT_EQ(std::string::npos, text.find("test_level 7"));
+}
+
+TEST(MetricsTest, NameCannotChangeType) {
+    auto& registry = metrics::Registry::Instance();
+    registry.GetHistogram("test_typed_seconds", "Test histogram");
+
+    EXPECT_THROW(registry.GetCounter("test_typed_seconds", "Test counter"), std::logic_error);
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include <crow.h>
+
+#include <chrono>
+#include <thread>
+
+#include "middleware/AdmissionMiddleware.hpp"
+
+namespace {
+    config::AdmissionConfiguration Configuration(const size_t initialLimit) {
+        config::AdmissionConfiguration configuration;
+        configuration.initialLimit = initialLimit;
+        configuration.minLimit = 1;
+        configuration.maxLimit = 100;
+        configuration.sampleWindow = 10;
+        return configuration;
+    }
+
+    // one window of requests, each holding the limiter as long as the others
+    void Window(admission::ConcurrencyLimiter& limiter, const size_t concurrency, const std::chrono::microseconds latency, const bool dropped = false) {
+        for (size_t i = 0; i < concurrency; i++) {
+            ASSERT_TRUE(limiter.TryAcquire());
+        }
+        for (size_t i = 0; i < concurrency; i++) {
+            limiter.Release(latency, dropped);
+        }
+    }
+}
+
+TEST(AdmissionMiddlewareTest, LimiterRejectsOverTheLimit) {
+    admission::ConcurrencyLimiter limiter(Configuration(2));
+
+    EXPECT_TRUE(limiter.TryAcquire());
+    EXPECT_TRUE(limiter.TryAcquire());
+    EXPECT_FALSE(limiter.TryAcquire());
+    limiter.Release(std::chrono::milliseconds(1), false);
+    EXPECT_TRUE(limiter.TryAcquire());
+
+    EXPECT_EQ(3, limiter.Stats().admitted.load());
+    EXPECT_EQ(1, limiter.Stats().rejected.load());
+    EXPECT_EQ(2, limiter.Inflight());
+}
+
+TEST(AdmissionMiddlewareTest, LimitGrowsWhileLatencyHolds) {
+    admission::ConcurrencyLimiter limiter(Configuration(10));
+
+    for (int i = 0; i < 5; i++) {
+        Window(limiter, 10, std::chrono::milliseconds(2));
+    }
+
+    EXPECT_GT(limiter.Limit(), 10);
+}
+
+TEST(AdmissionMiddlewareTest, LimitShrinksWhenLatencyRises) {
+    admission::ConcurrencyLimiter limiter(Configuration(20));
+    Window(limiter, 10, std::chrono::milliseconds(2));
+
+    for (int i = 0; i < 5; i++) {
+        Window(limiter, 10, std::chrono::milliseconds(20));
+    }
+
+    EXPECT_LT(limiter.Limit(), 20);
+}
+
+TEST(AdmissionMiddlewareTest, DroppedRequestsBackOff) {
+    admission::ConcurrencyLimiter limiter(Configuration(20));
+
+    Window(limiter, 10, std::chrono::seconds(5), true);
+
+    EXPECT_EQ(18, limiter.Limit());
+    EXPECT_EQ(10, limiter.Stats().dropped.load());
+}
+
+TEST(AdmissionMiddlewareTest, ShedRequestGetsRetryAfter) {
+    AdmissionMiddleware middleware;
+    auto limiter = std::make_shared<admission::ConcurrencyLimiter>(Configuration(1));
+    middleware.Configure(Configuration(1), limiter);
+    ASSERT_TRUE(limiter->TryAcquire());
+
+    crow::request request;
+    request.url = "/tournaments";
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+    middleware.after_handle(request, response, context);
+
+    EXPECT_EQ(crow::SERVICE_UNAVAILABLE, response.code);
+    EXPECT_EQ("1", response.get_header_value("Retry-After"));
+    EXPECT_EQ(1, limiter->Inflight());
+}
+
+TEST(AdmissionMiddlewareTest, HealthChecksAreNotShed) {
+    AdmissionMiddleware middleware;
+    auto limiter = std::make_shared<admission::ConcurrencyLimiter>(Configuration(1));
+    middleware.Configure(Configuration(1), limiter);
+    ASSERT_TRUE(limiter->TryAcquire());
+
+    crow::request request;
+    request.url = "/health";
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+
+    EXPECT_EQ(crow::OK, response.code);
+    EXPECT_FALSE(deadline::Remaining());
+}
+
+TEST(AdmissionMiddlewareTest, HeaderShortensTheDeadline) {
+    AdmissionMiddleware middleware;
+    const auto configuration = Configuration(4);
+    auto limiter = std::make_shared<admission::ConcurrencyLimiter>(configuration);
+    middleware.Configure(configuration, limiter);
+
+    crow::request request;
+    request.url = "/teams";
+    request.add_header(configuration.deadlineHeader, "200");
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+
+    const auto remaining = deadline::Remaining();
+    ASSERT_TRUE(remaining);
+    EXPECT_LE(remaining->count(), 200);
+    EXPECT_EQ(1, limiter->Inflight());
+
+    middleware.after_handle(request, response, context);
+    EXPECT_FALSE(deadline::Remaining());
+    EXPECT_EQ(0, limiter->Inflight());
+}
+
+TEST(AdmissionMiddlewareTest, ContextKeepsThePermitUntilTheResponseEnds) {
+    AdmissionMiddleware middleware;
+    const auto configuration = Configuration(4);
+    auto limiter = std::make_shared<admission::ConcurrencyLimiter>(configuration);
+    middleware.Configure(configuration, limiter);
+
+    crow::request request;
+    request.url = "/teams";
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+    ASSERT_TRUE(deadline::Remaining());
+    EXPECT_EQ(deadline::Current(), context.deadline);
+
+    // answered from another thread, as the handlers served by the async executor are
+    std::thread([&] {
+        EXPECT_FALSE(deadline::Remaining());
+        EXPECT_EQ(1, limiter->Inflight());
+        context.failure = admission::Failure::POOL_TIMEOUT;
+        response.code = crow::SERVICE_UNAVAILABLE;
+        middleware.after_handle(request, response, context);
+    }).join();
+
+    EXPECT_EQ(0, limiter->Inflight());
+    EXPECT_EQ(1, limiter->Stats().dropped.load());
+}
+
+TEST(AdmissionMiddlewareTest, HeaderCannotExtendTheDeadline) {
+    AdmissionMiddleware middleware;
+    const auto configuration = Configuration(4);
+    middleware.Configure(configuration, std::make_shared<admission::ConcurrencyLimiter>(configuration));
+
+    crow::request request;
+    request.url = "/teams";
+    request.add_header(configuration.deadlineHeader, "600000");
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+
+    const auto remaining = deadline::Remaining();
+    ASSERT_TRUE(remaining);
+    EXPECT_LE(remaining->count(), configuration.requestTimeout.count());
+    middleware.after_handle(request, response, context);
+}
+
+TEST(AdmissionMiddlewareTest, HeaderCannotGoBelowTheFloor) {
+    AdmissionMiddleware middleware;
+    const auto configuration = Configuration(4);
+    middleware.Configure(configuration, std::make_shared<admission::ConcurrencyLimiter>(configuration));
+
+    crow::request request;
+    request.url = "/teams";
+    request.add_header(configuration.deadlineHeader, "0");
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+
+    const auto remaining = deadline::Remaining();
+    ASSERT_TRUE(remaining);
+    EXPECT_GT(remaining->count(), configuration.minRequestTimeout.count() / 2);
+    middleware.after_handle(request, response, context);
+}
+
+TEST(AdmissionMiddlewareTest, ShortenedDeadlineIsNotADrop) {
+    AdmissionMiddleware middleware;
+    const auto configuration = Configuration(4);
+    auto limiter = std::make_shared<admission::ConcurrencyLimiter>(configuration);
+    middleware.Configure(configuration, limiter);
+
+    crow::request request;
+    request.url = "/teams";
+    request.add_header(configuration.deadlineHeader, "100");
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+    context.failure = admission::Failure::DEADLINE_EXCEEDED;
+    response.code = crow::SERVICE_UNAVAILABLE;
+    middleware.after_handle(request, response, context);
+
+    EXPECT_EQ(0, limiter->Stats().dropped.load());
+}
+
+TEST(AdmissionMiddlewareTest, PoolTimeoutIsADrop) {
+    AdmissionMiddleware middleware;
+    const auto configuration = Configuration(4);
+    auto limiter = std::make_shared<admission::ConcurrencyLimiter>(configuration);
+    middleware.Configure(configuration, limiter);
+
+    crow::request request;
+    request.url = "/teams";
+    request.add_header(configuration.deadlineHeader, "100");
+    crow::response response;
+    AdmissionMiddleware::context context;
+    middleware.before_handle(request, response, context);
+    context.failure = admission::Failure::POOL_TIMEOUT;
+    response.code = crow::SERVICE_UNAVAILABLE;
+    middleware.after_handle(request, response, context);
+
+    EXPECT_EQ(1, limiter->Stats().dropped.load());
+}
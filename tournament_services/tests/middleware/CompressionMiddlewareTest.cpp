@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <crow.h>
+#include <zlib.h>
+#include <zstd.h>
+
+#include "middleware/CompressionMiddleware.hpp"
+
+namespace {
+    std::string JsonBody(const size_t size) {
+        std::string body = "[";
+        while (body.size() < size) {
+            body += R"({"id":"3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10","name":"Team"},)";
+        }
+        body.back() = ']';
+        return body;
+    }
+
+    std::string Gunzip(const std::string& compressed, const size_t size) {
+        z_stream stream{};
+        inflateInit2(&stream, 16 + MAX_WBITS);
+        std::string output(size, '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+        stream.avail_in = static_cast<uInt>(compressed.size());
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        const int result = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        return result == Z_STREAM_END ? output.substr(0, stream.total_out) : std::string{};
+    }
+
+    struct CompressionFixture {
+        CompressionMiddleware middleware;
+        std::shared_ptr<compression::CompressionStats> stats = std::make_shared<compression::CompressionStats>();
+        crow::request request;
+        crow::response response;
+        CompressionMiddleware::context context;
+
+        CompressionFixture(const std::string& acceptEncoding, std::string body) {
+            middleware.Configure(config::CompressionConfiguration{}, stats);
+            request.add_header("Accept-Encoding", acceptEncoding);
+            response = crow::response{crow::OK, std::move(body)};
+            response.add_header("content-type", "application/json");
+        }
+
+        void Run() {
+            middleware.after_handle(request, response, context);
+        }
+    };
+}
+
+TEST(CompressionMiddlewareTest, NegotiatePrefersZstdOnTie) {
+    EXPECT_EQ(compression::Encoding::ZSTD, compression::Negotiate("gzip, deflate, br, zstd"));
+    EXPECT_EQ(compression::Encoding::GZIP, compression::Negotiate("gzip, deflate"));
+    EXPECT_EQ(compression::Encoding::GZIP, compression::Negotiate("zstd;q=0.5, GZIP;q=0.8"));
+    EXPECT_EQ(compression::Encoding::ZSTD, compression::Negotiate("*"));
+    EXPECT_EQ(compression::Encoding::GZIP, compression::Negotiate("zstd;q=0, *"));
+    EXPECT_EQ(compression::Encoding::IDENTITY, compression::Negotiate("gzip;q=0, identity"));
+    EXPECT_EQ(compression::Encoding::IDENTITY, compression::Negotiate(""));
+}
+
+TEST(CompressionMiddlewareTest, GzipRoundTrip) {
+    const auto body = JsonBody(4096);
+    CompressionFixture fixture("gzip", body);
+
+    fixture.Run();
+
+    EXPECT_EQ("gzip", fixture.response.get_header_value("Content-Encoding"));
+    EXPECT_EQ("Accept-Encoding", fixture.response.get_header_value("Vary"));
+    EXPECT_LT(fixture.response.body.size(), body.size());
+    EXPECT_EQ(body, Gunzip(fixture.response.body, body.size()));
+    EXPECT_EQ(1, fixture.stats->gzip.responses.load());
+    EXPECT_EQ(body.size(), fixture.stats->gzip.bytesIn.load());
+    EXPECT_EQ(fixture.response.body.size(), fixture.stats->gzip.bytesOut.load());
+}
+
+TEST(CompressionMiddlewareTest, ZstdRoundTrip) {
+    const auto body = JsonBody(4096);
+    CompressionFixture fixture("gzip, zstd", body);
+
+    fixture.Run();
+
+    ASSERT_EQ("zstd", fixture.response.get_header_value("Content-Encoding"));
+    std::string decompressed(body.size(), '\0');
+    const size_t size = ZSTD_decompress(decompressed.data(), decompressed.size(), fixture.response.body.data(), fixture.response.body.size());
+    ASSERT_FALSE(ZSTD_isError(size));
+    decompressed.resize(size);
+    EXPECT_EQ(body, decompressed);
+    EXPECT_EQ(1, fixture.stats->zstd.responses.load());
+}
+
+TEST(CompressionMiddlewareTest, SmallBodyIsSentAsIs) {
+    const auto body = JsonBody(100);
+    CompressionFixture fixture("gzip, zstd", body);
+
+    fixture.Run();
+
+    EXPECT_EQ(body, fixture.response.body);
+    EXPECT_TRUE(fixture.response.get_header_value("Content-Encoding").empty());
+    EXPECT_EQ(1, fixture.stats->belowThreshold.load());
+}
+
+TEST(CompressionMiddlewareTest, IdentityWhenNoCodingAccepted) {
+    const auto body = JsonBody(4096);
+    CompressionFixture fixture("identity", body);
+
+    fixture.Run();
+
+    EXPECT_EQ(body, fixture.response.body);
+    EXPECT_EQ("Accept-Encoding", fixture.response.get_header_value("Vary"));
+    EXPECT_EQ(1, fixture.stats->notAccepted.load());
+}
+
+TEST(CompressionMiddlewareTest, EncodedOrBinaryBodyIsLeftAlone) {
+    const auto body = JsonBody(4096);
+    CompressionFixture encoded("gzip", body);
+    encoded.response.add_header("Content-Encoding", "br");
+    CompressionFixture binary("gzip", body);
+    binary.response.set_header("content-type", "application/octet-stream");
+
+    encoded.Run();
+    binary.Run();
+
+    EXPECT_EQ(body, encoded.response.body);
+    EXPECT_EQ(body, binary.response.body);
+    EXPECT_EQ(0, encoded.stats->gzip.responses.load());
+    EXPECT_EQ(0, binary.stats->gzip.responses.load());
+}
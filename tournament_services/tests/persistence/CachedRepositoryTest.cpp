@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "domain/Team.hpp"
+#include "persistence/repository/CachedRepository.hpp"
+
+namespace {
+    constexpr domain::Id TEAM_ID = *domain::Id::Parse("3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10");
+    constexpr domain::Id OTHER_TEAM_ID = *domain::Id::Parse("9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384");
+}
+
+class TeamRepositoryMock : public IRepository<domain::Team, domain::Id> {
+public:
+    MOCK_METHOD(std::shared_ptr<domain::Team>, ReadById, (domain::Id id), (override));
+    MOCK_METHOD(domain::Id, Create, (const domain::Team& entity), (override));
+    MOCK_METHOD(domain::Id, Update, (const domain::Team& entity), (override));
+    MOCK_METHOD(void, Delete, (domain::Id id), (override));
+    MOCK_METHOD(std::vector<std::shared_ptr<domain::Team>>, ReadAll, (), (override));
+    MOCK_METHOD(Page<domain::Team>, ReadPage, (const PageRequest& request), (override));
+};
+
+class AsyncTeamRepositoryMock : public IAsyncRepository<domain::Team, domain::Id> {
+public:
+    MOCK_METHOD(void, ReadByIdAsync, (const domain::Id& id, deadline::Clock::time_point deadline, AsyncCompletion<std::shared_ptr<domain::Team>> completion), (override));
+    MOCK_METHOD(void, ReadPageAsync, (const PageRequest& request, deadline::Clock::time_point deadline, AsyncCompletion<Page<domain::Team>> completion), (override));
+};
+
+class CachedRepositoryTest : public ::testing::Test {
+protected:
+    std::shared_ptr<TeamRepositoryMock> repositoryMock;
+    std::shared_ptr<AsyncTeamRepositoryMock> asyncRepositoryMock;
+    std::shared_ptr<CachedRepository<domain::Team, domain::Id>> cachedRepository;
+
+    void SetUp() override {
+        repositoryMock = std::make_shared<TeamRepositoryMock>();
+        asyncRepositoryMock = std::make_shared<AsyncTeamRepositoryMock>();
+        config::CacheConfiguration configuration;
+        configuration.capacity = 100;
+        configuration.ttl = std::chrono::minutes(1);
+        // no broker in unit tests, invalidations stay local
+        cachedRepository = std::make_shared<CachedRepository<domain::Team, domain::Id>>(
+            repositoryMock, asyncRepositoryMock, nullptr, "teams", configuration);
+    }
+
+    static std::shared_ptr<domain::Team> Team(const domain::Id& id, const std::string& name) {
+        return std::make_shared<domain::Team>(domain::Team{id, name});
+    }
+};
+
+TEST_F(CachedRepositoryTest, SecondReadIsServedFromCache) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .Times(1)
+        .WillOnce(testing::Return(Team(TEAM_ID, "Tigres")));
+
+    const auto first = cachedRepository->ReadById(TEAM_ID);
+    const auto second = cachedRepository->ReadById(TEAM_ID);
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second->Name, "Tigres");
+    EXPECT_EQ(cachedRepository->Stats().hits.load(), 1);
+}
+
+TEST_F(CachedRepositoryTest, CachedReadReturnsACopy) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .WillOnce(testing::Return(Team(TEAM_ID, "Tigres")));
+
+    cachedRepository->ReadById(TEAM_ID);
+    const auto mutated = cachedRepository->ReadById(TEAM_ID);
+    mutated->Name = "Pumas";
+
+    EXPECT_EQ(cachedRepository->ReadById(TEAM_ID)->Name, "Tigres");
+}
+
+TEST_F(CachedRepositoryTest, MissingEntityIsNotCached) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .Times(2)
+        .WillRepeatedly(testing::Return(nullptr));
+
+    EXPECT_EQ(cachedRepository->ReadById(TEAM_ID), nullptr);
+    EXPECT_EQ(cachedRepository->ReadById(TEAM_ID), nullptr);
+    EXPECT_EQ(cachedRepository->Size(), 0);
+}
+
+TEST_F(CachedRepositoryTest, UpdateEvictsEntry) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .WillOnce(testing::Return(Team(TEAM_ID, "Tigres")))
+        .WillOnce(testing::Return(Team(TEAM_ID, "Pumas")));
+    EXPECT_CALL(*repositoryMock, Update(testing::_))
+        .WillOnce(testing::Return(TEAM_ID));
+
+    cachedRepository->ReadById(TEAM_ID);
+    cachedRepository->Update(domain::Team{TEAM_ID, "Pumas"});
+    const auto team = cachedRepository->ReadById(TEAM_ID);
+
+    ASSERT_NE(team, nullptr);
+    EXPECT_EQ(team->Name, "Pumas");
+}
+
+TEST_F(CachedRepositoryTest, DeleteEvictsEntry) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .WillOnce(testing::Return(Team(TEAM_ID, "Tigres")))
+        .WillOnce(testing::Return(nullptr));
+    EXPECT_CALL(*repositoryMock, Delete(TEAM_ID));
+
+    cachedRepository->ReadById(TEAM_ID);
+    cachedRepository->Delete(TEAM_ID);
+
+    EXPECT_EQ(cachedRepository->ReadById(TEAM_ID), nullptr);
+    EXPECT_EQ(cachedRepository->Size(), 0);
+}
+
+TEST_F(CachedRepositoryTest, WriteLeavesOtherEntriesCached) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .WillOnce(testing::Return(Team(TEAM_ID, "Tigres")));
+    EXPECT_CALL(*repositoryMock, ReadById(OTHER_TEAM_ID))
+        .Times(1)
+        .WillOnce(testing::Return(Team(OTHER_TEAM_ID, "Rayados")));
+    EXPECT_CALL(*repositoryMock, Delete(TEAM_ID));
+
+    cachedRepository->ReadById(TEAM_ID);
+    cachedRepository->ReadById(OTHER_TEAM_ID);
+    cachedRepository->Delete(TEAM_ID);
+
+    EXPECT_EQ(cachedRepository->ReadById(OTHER_TEAM_ID)->Name, "Rayados");
+}
+
+TEST_F(CachedRepositoryTest, AsyncReadIsCachedForLaterReads) {
+    EXPECT_CALL(*asyncRepositoryMock, ReadByIdAsync(TEAM_ID, testing::_, testing::_))
+        .WillOnce([](const domain::Id&, deadline::Clock::time_point, const AsyncCompletion<std::shared_ptr<domain::Team>>& completion) {
+            completion(Team(TEAM_ID, "Tigres"));
+        });
+    EXPECT_CALL(*repositoryMock, ReadById(testing::_)).Times(0);
+
+    std::shared_ptr<domain::Team> loaded;
+    cachedRepository->ReadByIdAsync(TEAM_ID, deadline::Clock::time_point::max(), [&loaded](auto team) { loaded = *team; });
+    const auto cached = cachedRepository->ReadById(TEAM_ID);
+
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->Name, "Tigres");
+}
+
+TEST_F(CachedRepositoryTest, AsyncReadHitCompletesWithoutQuerying) {
+    EXPECT_CALL(*repositoryMock, ReadById(TEAM_ID))
+        .WillOnce(testing::Return(Team(TEAM_ID, "Tigres")));
+    EXPECT_CALL(*asyncRepositoryMock, ReadByIdAsync(testing::_, testing::_, testing::_)).Times(0);
+
+    cachedRepository->ReadById(TEAM_ID);
+    std::shared_ptr<domain::Team> loaded;
+    cachedRepository->ReadByIdAsync(TEAM_ID, deadline::Clock::time_point::max(), [&loaded](auto team) { loaded = *team; });
+
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->Name, "Tigres");
+}
+
+TEST_F(CachedRepositoryTest, FailedAsyncReadIsNotCached) {
+    EXPECT_CALL(*asyncRepositoryMock, ReadByIdAsync(TEAM_ID, testing::_, testing::_))
+        .WillOnce([](const domain::Id&, deadline::Clock::time_point, const AsyncCompletion<std::shared_ptr<domain::Team>>& completion) {
+            completion(std::unexpected(AsyncError{AsyncError::Kind::DEADLINE, "late"}));
+        });
+
+    std::optional<AsyncError> error;
+    cachedRepository->ReadByIdAsync(TEAM_ID, deadline::Clock::time_point::max(), [&error](auto team) { error = team.error(); });
+
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->kind, AsyncError::Kind::DEADLINE);
+    EXPECT_EQ(cachedRepository->Size(), 0);
+}
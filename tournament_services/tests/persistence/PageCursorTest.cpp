@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "persistence/repository/Page.hpp"
+
+TEST(PageCursorTest, RoundTripsAPosition) {
+    const KeysetPosition position{"2025-09-01 12:34:56.123456", "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10"};
+
+    const auto decoded = cursor::Decode(cursor::Encode(position));
+
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(position.createdAt, decoded->createdAt);
+    EXPECT_EQ(position.id, decoded->id);
+}
+
+TEST(PageCursorTest, AcceptsWholeSeconds) {
+    EXPECT_TRUE(cursor::Decode(cursor::Encode({"2025-09-01 12:34:56", "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10"})));
+}
+
+TEST(PageCursorTest, RejectsAForgedTimestamp) {
+    const std::string id = "3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10";
+
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"yesterday", id})));
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"2025-02-30 12:00:00", id})));
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"2025-09-01 24:00:00", id})));
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"2025-09-01 12:00:00.1234567", id})));
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"2025-09-01 12:00:00'; --", id})));
+}
+
+TEST(PageCursorTest, RejectsAForgedId) {
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"2025-09-01 12:34:56", "not-a-uuid"})));
+    EXPECT_FALSE(cursor::Decode(cursor::Encode({"2025-09-01 12:34:56", ""})));
+}
+
+TEST(PageCursorTest, RejectsCharactersOutsideTheAlphabet) {
+    EXPECT_FALSE(cursor::Decode("abc$def"));
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+#include "persistence/repository/RequestCoalescer.hpp"
+
+namespace {
+    constexpr domain::Id TEAM_ID = *domain::Id::Parse("3f1c2a9e-6b7d-4c1e-9a55-0d2f8e7b4c10");
+    constexpr domain::Id OTHER_TEAM_ID = *domain::Id::Parse("9b2e4c71-0a3d-4f8e-b6c5-27d1e9f0a384");
+    constexpr domain::Id MISSING_ID = *domain::Id::Parse("5d8a0f13-c2e9-47b6-8a1f-e03c95b7d246");
+
+    config::CoalescingConfiguration Window(const std::chrono::microseconds window, const size_t maxBatchSize = 64) {
+        config::CoalescingConfiguration configuration;
+        configuration.batchWindow = window;
+        configuration.maxBatchSize = maxBatchSize;
+        return configuration;
+    }
+
+    std::vector<std::shared_ptr<domain::Team>> Teams(const std::vector<domain::Id>& ids) {
+        std::vector<std::shared_ptr<domain::Team>> teams;
+        for (const auto& id : ids) {
+            if (id != MISSING_ID) {
+                teams.push_back(std::make_shared<domain::Team>(domain::Team{id, "Team " + id.ToString()}));
+            }
+        }
+        return teams;
+    }
+}
+
+TEST(RequestCoalescerTest, ConcurrentReadsOfOneIdShareAQuery) {
+    std::atomic<int> calls{0};
+    RequestCoalescer<domain::Team> coalescer([&](const std::vector<domain::Id>& ids) {
+        calls++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return Teams(ids);
+    }, Window(std::chrono::microseconds(0)));
+
+    std::vector<std::shared_ptr<domain::Team>> results(8);
+    std::latch start(results.size());
+    std::vector<std::jthread> readers;
+    for (size_t i = 0; i < results.size(); i++) {
+        readers.emplace_back([&, i] {
+            start.arrive_and_wait();
+            results[i] = coalescer.Load(TEAM_ID);
+        });
+    }
+    readers.clear();
+
+    EXPECT_EQ(1, calls.load());
+    EXPECT_EQ(8, coalescer.Stats().requests.load());
+    EXPECT_EQ(7, coalescer.Stats().joined.load());
+    for (const auto& team : results) {
+        ASSERT_NE(nullptr, team);
+        EXPECT_EQ(TEAM_ID, team->Id);
+    }
+    // every reader gets its own instance
+    EXPECT_NE(results[0].get(), results[1].get());
+}
+
+TEST(RequestCoalescerTest, DistinctIdsWithinTheWindowAreBatched) {
+    std::atomic<int> calls{0};
+    std::vector<domain::Id> loaded;
+    RequestCoalescer<domain::Team> coalescer([&](const std::vector<domain::Id>& ids) {
+        calls++;
+        loaded = ids;
+        return Teams(ids);
+    }, Window(std::chrono::seconds(5), 3));
+
+    std::shared_ptr<domain::Team> first, second, missing;
+    {
+        std::jthread a([&] { first = coalescer.Load(TEAM_ID); });
+        std::jthread b([&] { second = coalescer.Load(OTHER_TEAM_ID); });
+        std::jthread c([&] { missing = coalescer.Load(MISSING_ID); });
+    }
+
+    // the batch filled up long before the window ran out
+    EXPECT_EQ(1, calls.load());
+    EXPECT_EQ(3, loaded.size());
+    EXPECT_EQ(1, coalescer.Stats().batches.load());
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    EXPECT_EQ(TEAM_ID, first->Id);
+    EXPECT_EQ(OTHER_TEAM_ID, second->Id);
+    EXPECT_EQ(nullptr, missing);
+}
+
+TEST(RequestCoalescerTest, NothingIsKeptAfterABatch) {
+    int calls = 0;
+    RequestCoalescer<domain::Team> coalescer([&](const std::vector<domain::Id>& ids) {
+        calls++;
+        return Teams(ids);
+    }, Window(std::chrono::microseconds(0)));
+
+    coalescer.Load(TEAM_ID);
+    coalescer.Load(TEAM_ID);
+
+    EXPECT_EQ(2, calls);
+    EXPECT_EQ(0, coalescer.Stats().joined.load());
+}
+
+TEST(RequestCoalescerTest, LoaderErrorReachesEveryReader) {
+    RequestCoalescer<domain::Team> coalescer([](const std::vector<domain::Id>&) -> std::vector<std::shared_ptr<domain::Team>> {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        throw std::runtime_error("connection lost");
+    }, Window(std::chrono::microseconds(0)));
+
+    std::atomic<int> failures{0};
+    {
+        std::vector<std::jthread> readers;
+        for (int i = 0; i < 4; i++) {
+            readers.emplace_back([&] {
+                try {
+                    coalescer.Load(TEAM_ID);
+                } catch (const std::runtime_error&) {
+                    failures++;
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(4, failures.load());
+}